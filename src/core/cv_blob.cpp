@@ -0,0 +1,198 @@
+#include "cv_blob.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace
+{
+    /// @brief 双线性插值的一个坐标轴: 源坐标下标与右侧/下侧权重
+    struct AXIS_TABLE
+    {
+        std::vector<int> index0;
+        std::vector<int> index1;
+        std::vector<float> weight;
+    };
+
+    /// @brief 生成坐标映射表, 与 cv::resize (INTER_LINEAR) 一样以像素中心对齐: src = (dst + 0.5) / Scale - 0.5
+    void makeAxisTable(int DstLen, int SrcLen, double Scale, AXIS_TABLE &Table)
+    {
+        Table.index0.resize(DstLen);
+        Table.index1.resize(DstLen);
+        Table.weight.resize(DstLen);
+        for (int i = 0; i < DstLen; i++)
+        {
+            double pos = (i + 0.5) / Scale - 0.5;
+            int i0 = static_cast<int>(std::floor(pos));
+            float w = static_cast<float>(pos - i0);
+            if (i0 < 0)
+            {
+                i0 = 0;
+                w = 0.0f;
+            }
+            if (i0 >= SrcLen - 1)
+            {
+                i0 = SrcLen - 1;
+                w = 0.0f;
+            }
+            Table.index0[i] = i0;
+            Table.index1[i] = std::min(i0 + 1, SrcLen - 1);
+            Table.weight[i] = w;
+        }
+    }
+
+    /// @brief 缩放、填充、归一化并按通道平面写入一个样本, 不生成中间图像
+    template <typename T>
+    void fillLetterbox(const cv::Mat &InMat, T *Planes, const pcv::BOX_RECT &Pads, const cv::Size &ContentSize,
+                       double Scale, const pcv::BLOB_PARAM &Param)
+    {
+        const int channels = InMat.channels();
+        const int width = Param.TargetSize.width;
+        const int height = Param.TargetSize.height;
+        const size_t planeSize = static_cast<size_t>(width) * height;
+
+        // 输出通道 k 取自输入通道 srcChannel[k]
+        int srcChannel[3] = {0, 1, 2};
+        if (channels == 3 && Param.SwapRB)
+            std::swap(srcChannel[0], srcChannel[2]);
+        float mul[3], add[3];
+        T padValue[3];
+        for (int k = 0; k < channels; k++)
+        {
+            mul[k] = static_cast<float>(Param.Scale[k]);
+            add[k] = static_cast<float>(-Param.Mean[k] * Param.Scale[k]);
+            padValue[k] = cv::saturate_cast<T>(Param.PadColor[srcChannel[k]] * mul[k] + add[k]);
+        }
+
+        AXIS_TABLE xTable, yTable;
+        makeAxisTable(ContentSize.width, InMat.cols, Scale, xTable);
+        makeAxisTable(ContentSize.height, InMat.rows, Scale, yTable);
+
+        cv::parallel_for_(cv::Range(0, height), [&](const cv::Range &range) {
+            for (int y = range.start; y < range.end; y++)
+            {
+                T *rows[3];
+                for (int k = 0; k < channels; k++)
+                    rows[k] = Planes + k * planeSize + static_cast<size_t>(y) * width;
+
+                int cy = y - Pads.top;
+                if (cy < 0 || cy >= ContentSize.height)
+                {
+                    for (int k = 0; k < channels; k++)
+                        std::fill(rows[k], rows[k] + width, padValue[k]);
+                    continue;
+                }
+                for (int k = 0; k < channels; k++)
+                {
+                    std::fill(rows[k], rows[k] + Pads.left, padValue[k]);
+                    std::fill(rows[k] + Pads.left + ContentSize.width, rows[k] + width, padValue[k]);
+                }
+
+                const uchar *src0 = InMat.ptr<uchar>(yTable.index0[cy]);
+                const uchar *src1 = InMat.ptr<uchar>(yTable.index1[cy]);
+                const float wy = yTable.weight[cy];
+                for (int x = 0; x < ContentSize.width; x++)
+                {
+                    const int x0 = xTable.index0[x] * channels;
+                    const int x1 = xTable.index1[x] * channels;
+                    const float wx = xTable.weight[x];
+                    for (int k = 0; k < channels; k++)
+                    {
+                        const int c = srcChannel[k];
+                        float top = src0[x0 + c] + (src0[x1 + c] - src0[x0 + c]) * wx;
+                        float bottom = src1[x0 + c] + (src1[x1 + c] - src1[x0 + c]) * wx;
+                        float v = top + (bottom - top) * wy;
+                        rows[k][Pads.left + x] = cv::saturate_cast<T>(v * mul[k] + add[k]);
+                    }
+                }
+            }
+        });
+    }
+
+    void checkBlobInput(const cv::Mat &InMat, const pcv::BLOB_PARAM &Param)
+    {
+        assert(!InMat.empty() && "Input image is empty");
+        if (InMat.depth() != CV_8U || (InMat.channels() != 1 && InMat.channels() != 3))
+        {
+            CV_Error(cv::Error::StsBadArg, "输入的InMat必须为8位单通道或三通道图像。");
+        }
+        if (Param.Depth != CV_32F && Param.Depth != CV_8S)
+        {
+            CV_Error(cv::Error::StsBadArg, "Depth只支持CV_32F与CV_8S。");
+        }
+    }
+
+    /// @brief 张量尺寸与类型匹配时复用, 否则重新分配
+    void createBlob(cv::Mat &Blob, int Num, int Channels, const pcv::BLOB_PARAM &Param)
+    {
+        const int sizes[4] = {Num, Channels, Param.TargetSize.height, Param.TargetSize.width};
+        Blob.create(4, sizes, Param.Depth);
+    }
+} // namespace
+
+/// @brief 等比例缩放填充并直接写入 NCHW 张量, 与 letterbox + 通道交换 + 归一化 + HWC 转 CHW 的结果一致
+/// 缩放、填充、归一化和平面化在一次遍历中完成
+/// @param InMat 输入图像(CV_8UC1 或 CV_8UC3)
+/// @param Blob 输出张量 (N, C, H, W); BatchIndex 为 0 且形状不符时重新分配为 (1, C, H, W), 否则写入已分配张量的第 BatchIndex 个样本
+/// @param Pads 输出填充大小
+/// @param Param 预处理参数
+/// @param BatchIndex 样本下标
+void pcv::letterboxBlob(const cv::Mat &InMat, cv::Mat &Blob, BOX_RECT &Pads, const BLOB_PARAM &Param, int BatchIndex)
+{
+    checkBlobInput(InMat, Param);
+    const int channels = InMat.channels();
+    bool matched = Blob.dims == 4 && Blob.type() == Param.Depth && Blob.size[0] > BatchIndex && Blob.size[1] == channels &&
+                   Blob.size[2] == Param.TargetSize.height && Blob.size[3] == Param.TargetSize.width && Blob.isContinuous();
+    if (!matched)
+    {
+        if (BatchIndex != 0)
+        {
+            CV_Error(cv::Error::StsBadArg, "Blob的形状与BatchIndex不匹配。");
+        }
+        createBlob(Blob, 1, channels, Param);
+    }
+
+    // 与 letterbox 相同的缩放比例与填充
+    float scale_w = (float)Param.TargetSize.width / InMat.cols;
+    float scale_h = (float)Param.TargetSize.height / InMat.rows;
+    double scale = std::min(scale_w, scale_h);
+    cv::Size contentSize(cv::saturate_cast<int>(InMat.cols * scale), cv::saturate_cast<int>(InMat.rows * scale));
+    int pad_width = Param.TargetSize.width - contentSize.width;
+    int pad_height = Param.TargetSize.height - contentSize.height;
+    Pads.left = pad_width / 2;
+    Pads.right = pad_width - Pads.left;
+    Pads.top = pad_height / 2;
+    Pads.bottom = pad_height - Pads.top;
+
+    const size_t sampleSize = static_cast<size_t>(channels) * Param.TargetSize.area();
+    if (Param.Depth == CV_32F)
+        fillLetterbox(InMat, Blob.ptr<float>() + BatchIndex * sampleSize, Pads, contentSize, scale, Param);
+    else
+        fillLetterbox(InMat, Blob.ptr<schar>() + BatchIndex * sampleSize, Pads, contentSize, scale, Param);
+}
+/// @brief 批量等比例缩放填充并写入同一个 NCHW 张量
+/// @param InMats 输入图像, 通道数需一致
+/// @param Blob 输出张量 (N, C, H, W), 形状匹配时复用
+/// @param Pads 输出每个样本的填充大小
+/// @param Param 预处理参数
+void pcv::letterboxBlob(const std::vector<cv::Mat> &InMats, cv::Mat &Blob, std::vector<BOX_RECT> &Pads, const BLOB_PARAM &Param)
+{
+    if (InMats.empty())
+    {
+        CV_Error(cv::Error::StsBadArg, "InMats不能为空。");
+    }
+    const int channels = InMats.front().channels();
+    for (const cv::Mat &image : InMats)
+    {
+        checkBlobInput(image, Param);
+        if (image.channels() != channels)
+        {
+            CV_Error(cv::Error::StsBadArg, "InMats的通道数不一致。");
+        }
+    }
+    createBlob(Blob, static_cast<int>(InMats.size()), channels, Param);
+    Pads.resize(InMats.size());
+    for (size_t i = 0; i < InMats.size(); i++)
+    {
+        letterboxBlob(InMats[i], Blob, Pads[i], Param, static_cast<int>(i));
+    }
+}
@@ -0,0 +1,27 @@
+#ifndef H_PCV_BLOB
+#define H_PCV_BLOB
+
+#include <vector>
+#include <opencv2/core.hpp>
+#include "cv_core.h"
+
+namespace pcv
+{
+    /// @brief 网络输入预处理参数
+    /// 输出值为 (像素 - Mean) * Scale, Mean 与 Scale 按交换通道后的顺序给出
+    struct BLOB_PARAM
+    {
+        cv::Size TargetSize = cv::Size(640, 640);                 // 网络输入尺寸
+        cv::Scalar Mean = cv::Scalar::all(0);                     // 各通道均值
+        cv::Scalar Scale = cv::Scalar::all(1.0 / 255);            // 各通道缩放系数
+        cv::Scalar PadColor = cv::Scalar(128, 128, 128);          // 填充颜色 (输入图像的通道顺序)
+        bool SwapRB = true;                                       // BGR 转 RGB
+        int Depth = CV_32F;                                       // 输出类型, CV_32F 或 CV_8S
+    };
+
+    void letterboxBlob(const cv::Mat &InMat, cv::Mat &Blob, BOX_RECT &Pads,
+                       const BLOB_PARAM &Param, int BatchIndex = 0);                      // 等比例缩放填充并写入 NCHW 张量的第 BatchIndex 个样本
+    void letterboxBlob(const std::vector<cv::Mat> &InMats, cv::Mat &Blob,
+                       std::vector<BOX_RECT> &Pads, const BLOB_PARAM &Param);             // 批量写入 NCHW 张量
+}; // namespace pcv
+#endif // H_PCV_BLOB
@@ -0,0 +1,183 @@
+#include "cv_buffer_pool.h"
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    /// @brief 同一规格的空闲缓冲
+    struct FREE_LIST
+    {
+        std::vector<cv::Mat> buffers;
+        uint64_t lastFrame = 0; // 最近一次申请或归还时的帧号
+    };
+
+    std::atomic<int64_t> g_cachedBytes{0}; // 所有线程缓存的字节数
+
+    inline int64_t getBufferBytes(const cv::Mat &Buffer)
+    {
+        return static_cast<int64_t>(Buffer.total() * Buffer.elemSize());
+    }
+
+    struct THREAD_CACHE;
+    std::mutex &getRegistryMutex()
+    {
+        static std::mutex mutex;
+        return mutex;
+    }
+    std::vector<THREAD_CACHE *> &getRegistry()
+    {
+        static std::vector<THREAD_CACHE *> registry;
+        return registry;
+    }
+
+    /// @brief 线程的空闲列表, 以 (行, 列, 类型) 为键; 登记在全局表中, 以便其他线程释放
+    /// 只有 clear / endFrame 会跨线程访问, 平时锁不存在竞争
+    struct THREAD_CACHE
+    {
+        std::mutex mutex;
+        std::unordered_map<uint64_t, FREE_LIST> lists;
+
+        THREAD_CACHE()
+        {
+            std::lock_guard<std::mutex> lock(getRegistryMutex());
+            getRegistry().push_back(this);
+        }
+        ~THREAD_CACHE()
+        {
+            {
+                std::lock_guard<std::mutex> lock(getRegistryMutex());
+                std::vector<THREAD_CACHE *> &registry = getRegistry();
+                registry.erase(std::remove(registry.begin(), registry.end(), this), registry.end());
+            }
+            prune(UINT64_MAX);
+        }
+        /// @brief 释放最近使用的帧号早于 MinFrame 的空闲列表, UINT64_MAX 时全部释放
+        void prune(uint64_t MinFrame)
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            for (auto it = this->lists.begin(); it != this->lists.end();)
+            {
+                if (MinFrame != UINT64_MAX && it->second.lastFrame >= MinFrame)
+                {
+                    ++it;
+                    continue;
+                }
+                for (const cv::Mat &buffer : it->second.buffers)
+                    g_cachedBytes.fetch_sub(getBufferBytes(buffer), std::memory_order_relaxed);
+                it = this->lists.erase(it);
+            }
+        }
+    };
+
+    THREAD_CACHE &getThreadCache()
+    {
+        thread_local THREAD_CACHE cache;
+        return cache;
+    }
+
+    inline uint64_t makeKey(int Rows, int Cols, int Type)
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(Rows)) << 36) ^
+               (static_cast<uint64_t>(static_cast<uint32_t>(Cols)) << 12) ^ static_cast<uint64_t>(Type & 0xFFF);
+    }
+} // namespace
+
+/// @brief 进程内共享的缓冲池, 空闲列表按线程独立, 统计为所有线程之和
+pcv::BufferPool &pcv::BufferPool::instance()
+{
+    static BufferPool pool;
+    return pool;
+}
+/// @brief 申请缓冲
+/// @param Rows 行数
+/// @param Cols 列数
+/// @param Type 类型
+/// @return 连续存储的缓冲, 内容未初始化
+cv::Mat pcv::BufferPool::acquire(int Rows, int Cols, int Type)
+{
+    THREAD_CACHE &cache = getThreadCache();
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        auto it = cache.lists.find(makeKey(Rows, Cols, Type));
+        if (it != cache.lists.end())
+        {
+            it->second.lastFrame = this->m_frame.load(std::memory_order_relaxed);
+            if (!it->second.buffers.empty())
+            {
+                cv::Mat buffer = std::move(it->second.buffers.back());
+                it->second.buffers.pop_back();
+                g_cachedBytes.fetch_sub(getBufferBytes(buffer), std::memory_order_relaxed);
+                this->m_hits.fetch_add(1, std::memory_order_relaxed);
+                return buffer;
+            }
+        }
+    }
+    this->m_misses.fetch_add(1, std::memory_order_relaxed);
+    return cv::Mat(Rows, Cols, Type);
+}
+/// @brief 归还缓冲; 缓冲仍被其他 Mat 引用、不连续、为子矩阵、过大或超出缓存上限时不回收
+/// @param Buffer 归还的缓冲, 随后被置空
+void pcv::BufferPool::release(cv::Mat &Buffer)
+{
+    if (Buffer.empty() || Buffer.dims > 2 || !Buffer.isContinuous() || !Buffer.u ||
+        Buffer.u->refcount != 1 || Buffer.datastart != Buffer.data ||
+        Buffer.dataend != Buffer.datastart + Buffer.total() * Buffer.elemSize())
+    {
+        Buffer.release();
+        return;
+    }
+    const int64_t bytes = getBufferBytes(Buffer);
+    if (bytes > this->m_maxBufferBytes.load(std::memory_order_relaxed))
+    {
+        Buffer.release();
+        return;
+    }
+    THREAD_CACHE &cache = getThreadCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    FREE_LIST &list = cache.lists[makeKey(Buffer.rows, Buffer.cols, Buffer.type())];
+    list.lastFrame = this->m_frame.load(std::memory_order_relaxed);
+    if (static_cast<int>(list.buffers.size()) < this->m_maxCachedPerKey.load(std::memory_order_relaxed))
+    {
+        // 先占用额度, 超出上限时退回
+        if (g_cachedBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes <=
+            this->m_maxCachedBytes.load(std::memory_order_relaxed))
+        {
+            list.buffers.push_back(std::move(Buffer));
+        }
+        else
+        {
+            g_cachedBytes.fetch_sub(bytes, std::memory_order_relaxed);
+        }
+    }
+    Buffer.release();
+}
+/// @brief 清空所有线程的空闲列表
+void pcv::BufferPool::clear()
+{
+    std::lock_guard<std::mutex> lock(getRegistryMutex());
+    for (THREAD_CACHE *cache : getRegistry())
+        cache->prune(UINT64_MAX);
+}
+/// @brief 结束一帧: 所有线程中本帧没有申请或归还过的规格被释放, 只保留最近一帧的工作集
+/// 图像尺寸变化后, 旧尺寸的缓冲在下一次 endFrame 时释放
+void pcv::BufferPool::endFrame()
+{
+    const uint64_t frame = this->m_frame.fetch_add(1, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(getRegistryMutex());
+    for (THREAD_CACHE *cache : getRegistry())
+        cache->prune(frame);
+}
+/// @brief 获取命中统计
+pcv::BufferPool::STATS pcv::BufferPool::getStats() const
+{
+    return {this->m_hits.load(std::memory_order_relaxed), this->m_misses.load(std::memory_order_relaxed),
+            g_cachedBytes.load(std::memory_order_relaxed)};
+}
+/// @brief 清零命中统计
+void pcv::BufferPool::resetStats()
+{
+    this->m_hits.store(0, std::memory_order_relaxed);
+    this->m_misses.store(0, std::memory_order_relaxed);
+}
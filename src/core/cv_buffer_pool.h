@@ -0,0 +1,76 @@
+#ifndef H_PCV_BUFFER_POOL
+#define H_PCV_BUFFER_POOL
+
+#include <atomic>
+#include <cstdint>
+#include <opencv2/core.hpp>
+
+namespace pcv
+{
+    /// @brief 临时缓冲池
+    /// 每个线程按 (行, 列, 类型) 维护空闲列表, 归还的缓冲在同一线程下次申请相同规格时直接复用,
+    /// 避免反复分配与释放大块内存。只有不再被其他 Mat 引用的缓冲才会被回收。
+    /// 所有线程缓存的总字节数不超过上限; 各线程的空闲列表登记在池中, clear / endFrame 可从任意线程释放,
+    /// 包括 OpenCV 工作线程上缓存的缓冲。
+    class BufferPool
+    {
+    public:
+        /// @brief 命中统计
+        struct STATS
+        {
+            int64_t hits;        // 从空闲列表取得
+            int64_t misses;      // 新分配
+            int64_t cachedBytes; // 当前缓存的字节数 (所有线程)
+        };
+
+        /// @brief 帧作用域, 析构时调用 endFrame
+        class FrameScope
+        {
+        public:
+            FrameScope() = default;
+            ~FrameScope() { BufferPool::instance().endFrame(); }
+            FrameScope(const FrameScope &) = delete;
+            FrameScope &operator=(const FrameScope &) = delete;
+        };
+
+        static BufferPool &instance();                          // 进程内共享的缓冲池
+
+        cv::Mat acquire(int Rows, int Cols, int Type);          // 申请缓冲, 内容未初始化
+        cv::Mat acquire(const cv::Size &Size, int Type) { return acquire(Size.height, Size.width, Type); }
+        void release(cv::Mat &Buffer);                          // 归还缓冲, Buffer 随后被置空
+        void clear();                                           // 清空所有线程的空闲列表
+        void endFrame();                                        // 结束一帧: 释放本帧未使用过的规格的缓冲
+        STATS getStats() const;                                 // 获取命中统计 (所有线程)
+        void resetStats();                                      // 清零命中统计
+        void setMaxCachedPerKey(int Num) { this->m_maxCachedPerKey = Num; }          // 每种规格最多缓存的缓冲数
+        void setMaxCachedBytes(int64_t Bytes) { this->m_maxCachedBytes = Bytes; }    // 缓存总字节数上限
+        void setMaxBufferBytes(int64_t Bytes) { this->m_maxBufferBytes = Bytes; }    // 单个缓冲超过该字节数时不缓存
+
+    private:
+        BufferPool() = default;
+
+        std::atomic<int64_t> m_hits{0};
+        std::atomic<int64_t> m_misses{0};
+        std::atomic<int> m_maxCachedPerKey{4};
+        std::atomic<int64_t> m_maxCachedBytes{int64_t(256) << 20};
+        std::atomic<int64_t> m_maxBufferBytes{int64_t(64) << 20};
+        std::atomic<uint64_t> m_frame{0};
+    };
+
+    /// @brief 作用域内的池化缓冲, 析构时自动归还
+    class PooledMat
+    {
+    public:
+        PooledMat(const cv::Size &Size, int Type) : m_mat(BufferPool::instance().acquire(Size, Type)) {}
+        ~PooledMat() { BufferPool::instance().release(this->m_mat); }
+        PooledMat(const PooledMat &) = delete;
+        PooledMat &operator=(const PooledMat &) = delete;
+
+        cv::Mat &get() { return this->m_mat; }
+        operator cv::Mat &() { return this->m_mat; }
+
+    private:
+        cv::Mat m_mat;
+    };
+}; // namespace pcv
+#endif // H_PCV_BUFFER_POOL
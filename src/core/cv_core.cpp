@@ -1,4 +1,7 @@
 #include "cv_core.h"
+#include "cv_buffer_pool.h"
+#include "cv_lbp.h"
+#include <opencv2/core/hal/intrin.hpp>
 #include <spdlog/spdlog.h>
 
 namespace pcv
@@ -50,22 +53,28 @@ namespace pcv
         float scale_h = (float)target_size.height / image.rows;
         float min_scale = std::min(scale_w, scale_h);
 
-        cv::Mat resized_image;
-        cv::resize(image, resized_image, cv::Size(), min_scale, min_scale);
+        // 与 cv::resize 按比例缩放时的输出尺寸一致
+        cv::Size resized_size(cv::saturate_cast<int>(image.cols * static_cast<double>(min_scale)),
+                              cv::saturate_cast<int>(image.rows * static_cast<double>(min_scale)));
 
         // 计算填充大小
-        int pad_width = target_size.width - resized_image.cols;
-        int pad_height = target_size.height - resized_image.rows;
+        int pad_width = target_size.width - resized_size.width;
+        int pad_height = target_size.height - resized_size.height;
 
         pads.left = pad_width / 2;
         pads.right = pad_width - pads.left;
         pads.top = pad_height / 2;
         pads.bottom = pad_height - pads.top;
 
-        // 在图像周围添加填充
-        cv::copyMakeBorder(resized_image, padded_image, pads.top, pads.bottom, pads.left, pads.right, cv::BORDER_CONSTANT, pad_color);
+        // 直接缩放到输出图像的内容区域, 不生成中间图像
+        cv::Mat src = (padded_image.data == image.data) ? image.clone() : image;
+        padded_image.create(target_size, image.type());
+        padded_image.setTo(pad_color);
+        cv::Mat content = padded_image(cv::Rect(pads.left, pads.top, resized_size.width, resized_size.height));
+        cv::resize(src, content, cv::Size(), min_scale, min_scale);
     }
-    /// @brief 二值化图像
+    /// @brief 二值化图像, 灰度位于 (MinGray, MaxGray] 的像素为 255, 其余为 0 (阈值先向下取整, 与 cv::threshold 一致)
+    /// 逐行以 SIMD 做区间比较, 单次遍历直接写出掩膜, 不产生中间图像
     /// @param GrayInMat 输入灰度图像
     /// @param OutMat 输出图像
     /// @param MinGray 区间灰度下限
@@ -77,10 +86,42 @@ namespace pcv
         assert(MinGray >= 0 && MinGray <= 255 && "MinGray must be in the range [0, 255]");
         assert(MaxGray >= 0 && MaxGray <= 255 && "MaxGray must be in the range [0, 255]");
 
-        cv::Mat thresMin, thresMax;
-        cv::threshold(GrayInMat, thresMin, MinGray, 255, cv::THRESH_BINARY_INV);
-        cv::threshold(GrayInMat, thresMax, MaxGray, 255, cv::THRESH_BINARY);
-        invertImage(thresMin + thresMax, OutMat);
+        const uchar minGray = cv::saturate_cast<uchar>(cvFloor(MinGray));
+        const uchar maxGray = cv::saturate_cast<uchar>(cvFloor(MaxGray));
+        cv::Mat src = GrayInMat;
+        OutMat.create(src.size(), CV_8UC1);
+        cv::parallel_for_(cv::Range(0, src.rows), [&](const cv::Range &range) {
+            for (int r = range.start; r < range.end; r++)
+            {
+                const uchar *in = src.ptr<uchar>(r);
+                uchar *out = OutMat.ptr<uchar>(r);
+                int c = 0;
+#if CV_SIMD
+                const int step = cv::v_uint8::nlanes;
+                const cv::v_uint8 vMin = cv::vx_setall_u8(minGray), vMax = cv::vx_setall_u8(maxGray);
+                for (; c <= src.cols - step; c += step)
+                {
+                    cv::v_uint8 v = cv::vx_load(in + c);
+                    cv::v_store(out + c, (v > vMin) & (v <= vMax));
+                }
+#endif
+                for (; c < src.cols; c++)
+                    out[c] = (in[c] > minGray && in[c] <= maxGray) ? 255 : 0;
+            }
+        });
+    }
+    /// @brief 自动阈值二值化, 灰度高于阈值的像素为 255, 与 cv::threshold 的 THRESH_OTSU / THRESH_TRIANGLE 一致
+    /// @param GrayInMat 输入灰度图像
+    /// @param OutMat 输出图像
+    /// @param Stats GrayInMat 的统计量
+    /// @param Method 阈值计算方法
+    /// @return 使用的阈值
+    int autoThreshold(const cv::Mat &GrayInMat, cv::Mat &OutMat, const ImageStats &Stats, AUTO_THRESHOLD Method)
+    {
+        assert(!Stats.empty() && "Stats is empty");
+        int thresh = (Method == AUTO_THRESHOLD::OTSU) ? Stats.getOtsuThreshold() : Stats.getTriangleThreshold();
+        threshold(GrayInMat, OutMat, thresh, 255);
+        return thresh;
     }
     /// @brief 反转图像像素
     /// @param InMat 输入图像
@@ -123,6 +164,29 @@ namespace pcv
         cv::Mat Lut(1, 256, CV_8UC1, lut.data());
         cv::LUT(GrayInMat, Lut, OutMat);
     }
+    /// @brief 按百分位数确定区间的灰度缩放, 忽略两端各 LowPercent% 与 (100 - HighPercent)% 的像素
+    /// @param GrayInMat 输入灰度图像
+    /// @param OutMat 输出图像
+    /// @param Stats GrayInMat 的统计量
+    /// @param LowPercent 区间下限的百分位 [0, 100]
+    /// @param HighPercent 区间上限的百分位 [0, 100]
+    void scaleImage(const cv::Mat &GrayInMat, cv::Mat &OutMat, const ImageStats &Stats, double LowPercent, double HighPercent)
+    {
+        assert(!Stats.empty() && "Stats is empty");
+        assert(LowPercent <= HighPercent && "LowPercent must not be greater than HighPercent");
+
+        int minGray = Stats.getPercentile(LowPercent);
+        int maxGray = Stats.getPercentile(HighPercent);
+        if (maxGray <= minGray)
+        {
+            // 区间退化时保持斜率有限
+            if (minGray < 255)
+                maxGray = minGray + 1;
+            else
+                minGray = maxGray - 1;
+        }
+        scaleImage(GrayInMat, OutMat, minGray, maxGray);
+    }
 
     /// @brief 灰度映射 (将灰度值映射到[0, MaxGrayLevel) 或 [0, MaxGrayLevel] 区间)
     /// @param GrayInOutMat 输入输出灰度图像
@@ -132,24 +196,77 @@ namespace pcv
     {
         assert(!GrayInOutMat.empty() && "Input image is empty");
         assert(GrayInOutMat.type() == CV_8UC1 && "Input image must be a grayscale image");
+
+        quantizeGray(GrayInOutMat, GrayInOutMat, MaxGrayLevel, IsClosed);
+    }
+    /// @brief 灰度映射, 最大灰度取自已有的统计量, 不再遍历图像
+    /// @param GrayInOutMat 输入输出灰度图像
+    /// @param Stats GrayInOutMat 的统计量
+    /// @param MaxGrayLevel 最大灰度值
+    /// @param IsClosed 是否封闭区间
+    void zoomGray(cv::Mat &GrayInOutMat, const ImageStats &Stats, int MaxGrayLevel, bool IsClosed)
+    {
+        assert(!GrayInOutMat.empty() && "Input image is empty");
+        assert(GrayInOutMat.type() == CV_8UC1 && "Input image must be a grayscale image");
+        assert(!Stats.empty() && "Stats is empty");
+
+        quantizeGray(GrayInOutMat, GrayInOutMat, MaxGrayLevel, IsClosed, Stats.getMax());
+    }
+
+    /// @brief 灰度量化, 结果与 zoomGray 相同
+    /// 按最大灰度生成量化查找表后单次查表, 图像始终以整数类型处理, 不转换为浮点
+    /// @param GrayInMat 输入灰度图像(CV_8UC1 或 CV_16UC1)
+    /// @param OutMat 输出图像(CV_8UC1), 可与输入相同
+    /// @param MaxGrayLevel 最大灰度值
+    /// @param IsClosed 是否封闭区间
+    /// @param MaxGray 输入图像的最大灰度, 负数时由图像统计; 调用方已知时传入可省去一次遍历
+    void quantizeGray(const cv::Mat &GrayInMat, cv::Mat &OutMat, int MaxGrayLevel, bool IsClosed, int MaxGray)
+    {
+        assert(!GrayInMat.empty() && "Input image is empty");
+        assert((GrayInMat.type() == CV_8UC1 || GrayInMat.type() == CV_16UC1) && "Input image must be a 8-bit or 16-bit grayscale image");
         assert(MaxGrayLevel >= 1 && MaxGrayLevel <= 256 && "MaxGrayLevel must be in the range [1, 256]");
-        GrayInOutMat.convertTo(GrayInOutMat, CV_32F);
-        double minVal, maxVal;
-        cv::minMaxLoc(GrayInOutMat, &minVal, &maxVal);
-        if (maxVal == 0)
-            maxVal = 1;
-        float scale = (MaxGrayLevel - (IsClosed ? 0.0f : 1.0f)) / static_cast<float>(maxVal);
-        if (IsClosed)
+
+        if (MaxGray < 0)
         {
-            // 封闭区间映射到 [0, MaxGrayLevel]
-            GrayInOutMat = cv::min(cv::max(GrayInOutMat * scale + 0.5f, 0.0f), static_cast<float>(MaxGrayLevel));
+            double maxVal;
+            cv::minMaxLoc(GrayInMat, nullptr, &maxVal);
+            MaxGray = static_cast<int>(maxVal);
         }
-        else
+        if (MaxGray == 0)
+            MaxGray = 1;
+
+        // 查找表覆盖 [0, MaxGray], 各项仍按 zoomGray 的浮点公式计算, 只需计算 MaxGray + 1 次
+        const int lutSize = MaxGray + 1;
+        std::vector<uchar> lut(GrayInMat.depth() == CV_8U ? 256 : lutSize, 0);
+        float scale = (MaxGrayLevel - (IsClosed ? 0.0f : 1.0f)) / static_cast<float>(MaxGray);
+        for (int i = 0; i < lutSize && i < static_cast<int>(lut.size()); i++)
         {
-            // 非封闭区间映射到 [0, MaxGrayLevel - 1]
-            GrayInOutMat = cv::min(cv::max(GrayInOutMat * scale, 0.0f), MaxGrayLevel - 1.0f);
+            float v = IsClosed ? std::min(i * scale + 0.5f, static_cast<float>(MaxGrayLevel))
+                               : std::min(i * scale, MaxGrayLevel - 1.0f);
+            lut[i] = cv::saturate_cast<uchar>(v);
         }
-        GrayInOutMat.convertTo(GrayInOutMat, CV_8U);
+
+        if (GrayInMat.depth() == CV_8U)
+        {
+            // 高于 MaxGray 的灰度与 16 位路径一样饱和到 lut[MaxGray]
+            if (MaxGray < 255)
+                std::fill(lut.begin() + lutSize, lut.end(), lut[MaxGray]);
+            cv::LUT(GrayInMat, cv::Mat(1, 256, CV_8UC1, lut.data()), OutMat);
+            return;
+        }
+
+        // 16 位输入逐行查表, 输出 8 位
+        cv::Mat src = GrayInMat;
+        OutMat.create(src.size(), CV_8UC1);
+        cv::parallel_for_(cv::Range(0, src.rows), [&](const cv::Range &range) {
+            for (int r = range.start; r < range.end; r++)
+            {
+                const ushort *in = src.ptr<ushort>(r);
+                uchar *out = OutMat.ptr<uchar>(r);
+                for (int c = 0; c < src.cols; c++)
+                    out[c] = lut[std::min<int>(in[c], MaxGray)];
+            }
+        });
     }
 
     /// @brief 伽马校正
@@ -177,16 +294,58 @@ namespace pcv
     /// @param OutMat 输出图像
     /// @param C 目标平均灰度值[0-1]
     void autoGammaImage(const cv::Mat &GrayInMat, cv::Mat &OutMat, float C)
+    {
+        assert(!GrayInMat.empty() && "Input image is empty");
+        assert(GrayInMat.type() == CV_8UC1 && "Input image must be a grayscale image");
+
+        autoGammaImage(GrayInMat, OutMat, C, ImageStats(GrayInMat));
+    }
+    /// @brief 自动伽马校正, 平均灰度取自已有的统计量
+    /// @param InMat 输入图像
+    /// @param OutMat 输出图像
+    /// @param C 目标平均灰度值[0-1]
+    /// @param Stats GrayInMat 的统计量
+    void autoGammaImage(const cv::Mat &GrayInMat, cv::Mat &OutMat, float C, const ImageStats &Stats)
     {
         assert(!GrayInMat.empty() && "Input image is empty");
         assert(GrayInMat.type() == CV_8UC1 && "Input image must be a grayscale image");
         assert(C >= 0 && C <= 1 && "C must be in the range [0, 1]");
+        assert(!Stats.empty() && "Stats is empty");
 
-        auto meanGray = cv::mean(GrayInMat)[0];
+        auto meanGray = Stats.getMean();
         float gamma_val = static_cast<float>(log10(1 - C) / log10(1 - meanGray / 255.0f)); // 自动gamma参数
         gammaImage(GrayInMat, OutMat, gamma_val);
     }
 
+    /// @brief 生成分段线性变换的查找表, 折点为 (Th1, Goal1) 与 (Th2, Goal2)
+    /// 查找表可跨帧缓存, 以 cv::LUT 作用于任意通道数的 8 位图像
+    /// @param Th1 第一个折点的输入灰度
+    /// @param Th2 第二个折点的输入灰度
+    /// @param Goal1 第一个折点的输出灰度
+    /// @param Goal2 第二个折点的输出灰度
+    /// @param OutLut 输出查找表(1x256, CV_8UC1)
+    void linearLevelLut(int Th1, int Th2, int Goal1, int Goal2, cv::Mat &OutLut)
+    {
+        assert(Th1 >= 0 && Th1 <= 255 && "Th1 must be in the range [0, 255]");
+        assert(Th2 >= 0 && Th2 <= 255 && "Th2 must be in the range [0, 255]");
+        assert(Goal1 >= 0 && Goal1 <= 255 && "Goal1 must be in the range [0, 255]");
+        assert(Goal2 >= 0 && Goal2 <= 255 && "Goal2 must be in the range [0, 255]");
+
+        OutLut.create(1, 256, CV_8UC1);
+        uchar *lut = OutLut.ptr<uchar>();
+        for (int i = 0; i < 256; i++)
+        {
+            float pixel = static_cast<float>(i);
+            if (i <= Th1)
+                pixel = (Th1 == 0) ? static_cast<float>(Goal1) : pixel * Goal1 / Th1;
+            else if (i <= Th2)
+                pixel = (pixel - Th1) * (Goal2 - Goal1) / (Th2 - Th1) + Goal1;
+            else
+                pixel = (pixel - Th2) * (255 - Goal2) / (255 - Th2) + Goal2;
+            lut[i] = cv::saturate_cast<uchar>(pixel);
+        }
+    }
+
     /// @brief 线性灰度变换
     /// @param GrayInMat 输入灰度图像
     /// @param OutMat 输出图像
@@ -198,30 +357,11 @@ namespace pcv
     {
         assert(!GrayInMat.empty() && "Input image is empty");
         assert(GrayInMat.type() == CV_8UC1 && "Input image must be a grayscale image");
-        assert(Th1 >= 0 && Th1 <= 255 && "Th1 must be in the range [0, 255]");
-        assert(Th2 >= 0 && Th2 <= 255 && "Th2 must be in the range [0, 255]");
-        assert(Goal1 >= 0 && Goal1 <= 255 && "Goal1 must be in the range [0, 255]");
-        assert(Goal2 >= 0 && Goal2 <= 255 && "Goal2 must be in the range [0, 255]");
-
-        cv::Mat temp;
-        GrayInMat.convertTo(temp, CV_32F);
 
-        for (int i = 0; i < temp.rows; i++)
-        {
-            for (int j = 0; j < temp.cols; j++)
-            {
-                if (temp.at<float>(i, j) <= Th1)
-                    temp.at<float>(i, j) = temp.at<float>(i, j) * Goal1 / Th1;
-                else if (temp.at<float>(i, j) > Th1 && temp.at<float>(i, j) <= Th2)
-                    temp.at<float>(i, j) = (temp.at<float>(i, j) - Th1) * (Goal2 - Goal1) / (Th2 - Th1) + Goal1;
-                else
-                    temp.at<float>(i, j) = (temp.at<float>(i, j) - Th2) * (255 - Goal2) / (255 - Th2) + Goal2;
-            }
-        }
-        temp.convertTo(OutMat, CV_8U);
+        linearLevelTrans(GrayInMat, OutMat, Th1, Th2, Goal1, Goal2);
     }
 
-    /// @brief 线性变换
+    /// @brief 线性变换, 对 8 位图像的每个通道查表, 不生成浮点中间图像
     /// @param InMat 输入图像
     /// @param OutMat 输出图像
     /// @param Th1
@@ -231,32 +371,13 @@ namespace pcv
     void linearLevelTrans(const cv::Mat &InMat, cv::Mat &OutMat, int Th1, int Th2, int Goal1, int Goal2)
     {
         assert(!InMat.empty() && "Input image is empty");
-        assert(Th1 >= 0 && Th1 <= 255 && "Th1 must be in the range [0, 255]");
-        assert(Th2 >= 0 && Th2 <= 255 && "Th2 must be in the range [0, 255]");
-        assert(Goal1 >= 0 && Goal1 <= 255 && "Goal1 must be in the range [0, 255]");
-        assert(Goal2 >= 0 && Goal2 <= 255 && "Goal2 must be in the range [0, 255]");
-
-        cv::Mat temp;
-        InMat.convertTo(temp, CV_32F);
+        assert(InMat.depth() == CV_8U && "Input image must be an 8-bit image");
 
-        for (int i = 0; i < temp.rows; i++)
-        {
-            for (int j = 0; j < temp.cols; j++)
-            {
-                for (int c = 0; c < 3; c++)
-                {
-                    float &pixel = temp.at<cv::Vec3f>(i, j)[c];
-                    if (pixel <= Th1)
-                        pixel = pixel * Goal1 / Th1;
-                    else if (pixel > Th1 && pixel <= Th2)
-                        pixel = (pixel - Th1) * (Goal2 - Goal1) / (Th2 - Th1) + Goal1;
-                    else
-                        pixel = (pixel - Th2) * (255 - Goal2) / (255 - Th2) + Goal2;
-                }
-            }
-        }
-
-        temp.convertTo(OutMat, CV_8U);
+        // 查找表使用栈上内存, 不产生堆分配
+        std::array<uchar, 256> lut;
+        cv::Mat Lut(1, 256, CV_8UC1, lut.data());
+        linearLevelLut(Th1, Th2, Goal1, Goal2, Lut);
+        cv::LUT(InMat, Lut, OutMat);
     }
 
     /// @brief 对数变换
@@ -283,48 +404,112 @@ namespace pcv
         assert(!InMat.empty() && "Input image is empty");
         assert(InMat.channels() == 3 && "Input image must be a color image");
 
-        // 将图像从 BGR 转换为 Lab 色彩空间
-        cv::Mat Lab;
+        // 将图像从 BGR 转换为 Lab 色彩空间 (中间缓冲取自缓冲池)
+        PooledMat labBuffer(InMat.size(), InMat.type());
+        PooledMat lightnessBuffer(InMat.size(), CV_MAKETYPE(InMat.depth(), 1));
+        cv::Mat &Lab = labBuffer.get();
+        cv::Mat &lightness = lightnessBuffer.get();
         cv::cvtColor(InMat, Lab, cv::COLOR_BGR2Lab);
 
-        // 分离 Lab 图像的通道
-        std::vector<cv::Mat> channels(3);
-        cv::split(Lab, channels);
+        // 取出 L 通道
+        cv::extractChannel(Lab, lightness, 0);
 
         // 创建 CLAHE 对象并设置剪切限制
         cv::Ptr<cv::CLAHE> clahe = cv::createCLAHE();
         clahe->setClipLimit(ClipLimit);
 
         // 对 L 通道应用 CLAHE
-        clahe->apply(channels[0], channels[0]);
+        clahe->apply(lightness, lightness);
 
-        // 合并通道并转换回 BGR 色彩空间
-        cv::merge(channels, Lab);
+        // 写回 L 通道并转换回 BGR 色彩空间
+        cv::insertChannel(lightness, Lab, 0);
         cv::cvtColor(Lab, OutMat, cv::COLOR_Lab2BGR);
     }
 
     /// @brief 多重双边滤波
+    /// 迭代在两个预分配缓冲之间交替进行, 最后一次直接写入 OutMat, 不再逐次复制中间结果
     /// @param InMat 输入图像
     /// @param OutMat 输出图像
     /// @param Iter 迭代次数
     /// @param D Diameter of each pixel neighborhood that is used during filtering. If it is non-positive, it is computed from sigmaSpace.
     /// @param SColor Filter sigma in the color space. A larger value of the parameter means that farther colors within the pixel neighborhood (see sigmaSpace) will be mixed together, resulting in larger areas of semi-equal color.
     /// @param SSpace Filter sigma in the coordinate space. A larger value of the parameter means that farther pixels will influence each other as long as their colors are close enough (see sigmaColor ). When d>0, it specifies the neighborhood size regardless of sigmaSpace. Otherwise, d is proportional to sigmaSpace.
-    void bilateralFilter(const cv::Mat &InMat, cv::Mat &OutMat, int Iter, int D, int SColor, int SSpace)
+    /// @param Mode 滤波方式, GUIDED 为以自身为引导图的导向滤波近似, 耗时与 D 无关
+    void bilateralFilter(const cv::Mat &InMat, cv::Mat &OutMat, int Iter, int D, int SColor, int SSpace, BILATERAL_MODE Mode)
     {
         assert(!InMat.empty() && "Input image is empty");
+        Iter = std::max(Iter, 1);
+
+        if (Mode == BILATERAL_MODE::GUIDED)
+        {
+            guidedBilateralFilter(InMat, OutMat, Iter, D, SColor, SSpace);
+            return;
+        }
+
+        // cv::bilateralFilter 不支持原地计算, 输出与输入共享内存时另行分配
+        cv::Mat src = InMat;
+        cv::Mat result = (OutMat.data == InMat.data) ? cv::Mat() : OutMat;
+        if (Iter == 1)
+        {
+            cv::bilateralFilter(src, result, D, SColor, SSpace);
+            OutMat = result;
+            return;
+        }
+        PooledMat scratchBuffer(src.size(), src.type());
+        cv::Mat &scratch = scratchBuffer.get();
+        // 按迭代次数的奇偶选择首个输出缓冲, 使最后一次迭代写入 result
+        cv::Mat *buffers[2] = {&result, &scratch};
+        int current = (Iter % 2 == 1) ? 0 : 1;
+        cv::bilateralFilter(src, *buffers[current], D, SColor, SSpace);
+        for (int i = 1; i < Iter; i++)
+        {
+            cv::bilateralFilter(*buffers[current], *buffers[1 - current], D, SColor, SSpace);
+            current = 1 - current;
+        }
+        OutMat = result;
+    }
 
-        cv::Mat bilateral, bilateral_temp;
-        cv::bilateralFilter(InMat, bilateral, D, SColor, SSpace);
-        bilateral_temp = bilateral.clone();
-        bilateral.release();
-        for (int i = 0; i < Iter - 1; i++)
+    /// @brief 导向滤波近似的双边滤波 (以自身为引导图), 盒式滤波实现, 耗时与邻域大小无关
+    /// @param InMat 输入图像 (8 位, 任意通道数, 各通道独立)
+    /// @param OutMat 输出图像
+    /// @param Iter 迭代次数
+    /// @param D 邻域直径, 非正数时由 SSpace 计算 (与 cv::bilateralFilter 相同)
+    /// @param SColor 颜色空间标准差, 正则项取 SColor^2
+    /// @param SSpace 坐标空间标准差
+    void guidedBilateralFilter(const cv::Mat &InMat, cv::Mat &OutMat, int Iter, int D, int SColor, int SSpace)
+    {
+        assert(!InMat.empty() && "Input image is empty");
+        assert(InMat.depth() == CV_8U && "Input image must be an 8-bit image");
+
+        int radius = (D > 0) ? D / 2 : cvRound(SSpace * 1.5);
+        radius = std::max(radius, 1);
+        const cv::Size window(2 * radius + 1, 2 * radius + 1);
+        const double eps = static_cast<double>(SColor) * SColor;
+
+        const int floatType = CV_MAKETYPE(CV_32F, InMat.channels());
+        // 四个缓冲: a 复用 corrI, b 复用 temp
+        PooledMat guideBuffer(InMat.size(), floatType), meanBuffer(InMat.size(), floatType);
+        PooledMat corrBuffer(InMat.size(), floatType), tempBuffer(InMat.size(), floatType);
+        cv::Mat &guide = guideBuffer.get(), &meanI = meanBuffer.get(), &corrI = corrBuffer.get(), &temp = tempBuffer.get();
+        InMat.convertTo(guide, CV_32F);
+        for (int i = 0; i < std::max(Iter, 1); i++)
         {
-            cv::bilateralFilter(bilateral_temp, bilateral, D, SColor, SSpace);
-            bilateral_temp = bilateral.clone();
-            bilateral.release();
+            cv::boxFilter(guide, meanI, CV_32F, window);
+            cv::multiply(guide, guide, corrI);
+            cv::boxFilter(corrI, corrI, CV_32F, window);
+            // var = E[I^2] - E[I]^2, a = var / (var + eps), b = E[I] - a * E[I]
+            cv::multiply(meanI, meanI, temp);
+            cv::subtract(corrI, temp, corrI);
+            cv::add(corrI, cv::Scalar::all(eps), temp);
+            cv::divide(corrI, temp, corrI);
+            cv::multiply(corrI, meanI, temp);
+            cv::subtract(meanI, temp, temp);
+            cv::boxFilter(corrI, corrI, CV_32F, window);
+            cv::boxFilter(temp, temp, CV_32F, window);
+            cv::multiply(corrI, guide, guide);
+            cv::add(guide, temp, guide);
         }
-        OutMat = bilateral_temp.clone();
+        guide.convertTo(OutMat, InMat.depth());
     }
 
     /// @brief Gabor 滤波
@@ -343,7 +528,8 @@ namespace pcv
         assert(!GrayInMat.empty() && "Input image is empty");
         assert(GrayInMat.type() == CV_8UC1 && "Input image must be a grayscale image");
 
-        cv::Mat temp;
+        PooledMat tempBuffer(GrayInMat.size(), CV_32FC1);
+        cv::Mat &temp = tempBuffer.get();
         GrayInMat.convertTo(temp, CV_32F);
         cv::Mat kernel = cv::getGaborKernel(cv::Size(KernelSize, KernelSize), Sigma, Theta, Lambd, Gamma, Psi, CV_32F);
         filter2D(temp, OutMat, CV_32F, kernel);                 // 在频域滤波，有负数
@@ -352,6 +538,7 @@ namespace pcv
     }
 
     /// @brief LBP 纹理特征提取
+    /// 原始 8 邻域编码, 由 calcLBP 逐行 SIMD 计算; 输出与输入逐像素对齐, 四周一圈像素编码为 0。
     /// @param GrayInMat 输入灰度图像
     /// @param OutMat 输出图像
     void LBP(const cv::Mat &GrayInMat, cv::Mat &OutMat)
@@ -359,27 +546,7 @@ namespace pcv
         assert(!GrayInMat.empty() && "Input image is empty");
         assert(GrayInMat.type() == CV_8UC1 && "Input image must be a grayscale image");
 
-        cv::Mat temp = cv::Mat::zeros(GrayInMat.size(), GrayInMat.type());
-        cv::Mat InMat;
-        cv::copyMakeBorder(GrayInMat, InMat, 0, 2, 0, 2, cv::BORDER_CONSTANT, cv::Scalar::all(0));
-        for (int i = 1; i < InMat.rows - 1; i++)
-        {
-            for (int j = 1; j < InMat.cols - 1; j++)
-            {
-                uchar center = InMat.at<uchar>(i, j);
-                uchar code = 0;
-                code |= (InMat.at<uchar>(i - 1, j - 1) >= center) << 7;
-                code |= (InMat.at<uchar>(i - 1, j) >= center) << 6;
-                code |= (InMat.at<uchar>(i - 1, j + 1) >= center) << 5;
-                code |= (InMat.at<uchar>(i, j + 1) >= center) << 4;
-                code |= (InMat.at<uchar>(i + 1, j + 1) >= center) << 3;
-                code |= (InMat.at<uchar>(i + 1, j) >= center) << 2;
-                code |= (InMat.at<uchar>(i + 1, j - 1) >= center) << 1;
-                code |= (InMat.at<uchar>(i, j - 1) >= center) << 0;
-                temp.at<uchar>(i - 1, j - 1) = code;
-            }
-        }
-        OutMat = temp.clone();
+        calcLBP(GrayInMat, OutMat, LBP_TYPE::DEFAULT);
     }
 
 } // namespace pcv
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define H_PCV_CORE
 
 #include <opencv2/opencv.hpp>
+#include "cv_stats.h"
 
 namespace pcv
 {
@@ -24,16 +25,34 @@ void letterbox(const cv::Mat &image, cv::Mat &padded_image, BOX_RECT &pads,
 
 void threshold(const cv::Mat &GrayInMat, cv::Mat &OutMat, double MinGray, double MaxGray);
 
+enum class AUTO_THRESHOLD
+{
+    OTSU,     // 类间方差最大
+    TRIANGLE  // 三角法, 适合单峰直方图
+};
+
+int autoThreshold(const cv::Mat &GrayInMat, cv::Mat &OutMat, const ImageStats &Stats, AUTO_THRESHOLD Method);
+
 void invertImage(const cv::Mat &InMat, cv::Mat &OutMat);
 
 void scaleImage(const cv::Mat &GrayInMat, cv::Mat &OutMat, double MinGray, double MaxGray);
 
+void scaleImage(const cv::Mat &GrayInMat, cv::Mat &OutMat, const ImageStats &Stats, double LowPercent, double HighPercent);
+
 void zoomGray(cv::Mat &GrayInOutMat, int MaxGrayLevel, bool IsClosed = true);
 
+void zoomGray(cv::Mat &GrayInOutMat, const ImageStats &Stats, int MaxGrayLevel, bool IsClosed = true);
+
+void quantizeGray(const cv::Mat &GrayInMat, cv::Mat &OutMat, int MaxGrayLevel, bool IsClosed = true, int MaxGray = -1);
+
 void gammaImage(const cv::Mat &InMat, cv::Mat &OutMat, float Gamma);
 
 void autoGammaImage(const cv::Mat &GrayInMat, cv::Mat &OutMat, float C);
 
+void autoGammaImage(const cv::Mat &GrayInMat, cv::Mat &OutMat, float C, const ImageStats &Stats);
+
+void linearLevelLut(int Th1, int Th2, int Goal1, int Goal2, cv::Mat &OutLut);
+
 void linearGrayLevelTrans(const cv::Mat &GrayInMat, cv::Mat &OutMat, int Th1, int Th2, int Goal1, int Goal2);
 
 void linearLevelTrans(const cv::Mat &InMat, cv::Mat &OutMat, int Th1, int Th2, int Goal1, int Goal2);
@@ -42,7 +61,16 @@ void logImage(const cv::Mat &InMat, cv::Mat &OutMat, float C);
 
 void equalizeColor(const cv::Mat &InMat, cv::Mat &OutMat, double ClipLimit = 2.0);
 
-void bilateralFilter(const cv::Mat& InMat, cv::Mat& OutMat, int Iter, int D, int SColor, int SSpace);
+enum class BILATERAL_MODE
+{
+    EXACT,  // cv::bilateralFilter
+    GUIDED  // 导向滤波近似, 耗时与 D 无关
+};
+
+void bilateralFilter(const cv::Mat& InMat, cv::Mat& OutMat, int Iter, int D, int SColor, int SSpace,
+                     BILATERAL_MODE Mode = BILATERAL_MODE::EXACT);
+
+void guidedBilateralFilter(const cv::Mat &InMat, cv::Mat &OutMat, int Iter, int D, int SColor, int SSpace);
 
 void gaborFilter(const cv::Mat &GrayInMat, cv::Mat &OutMat, int KernelSize, 
                     double Sigma, double Theta, double Lambd, 
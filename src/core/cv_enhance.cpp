@@ -0,0 +1,201 @@
+#include "cv_enhance.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace
+{
+    /// @brief 按采样网格估计平均灰度
+    double sampleMean(const cv::Mat &GrayInMat, int Step)
+    {
+        if (Step <= 1)
+            return cv::mean(GrayInMat)[0];
+        int64 sum = 0, num = 0;
+        for (int r = Step / 2; r < GrayInMat.rows; r += Step)
+        {
+            const uchar *row = GrayInMat.ptr<uchar>(r);
+            for (int c = Step / 2; c < GrayInMat.cols; c += Step)
+                sum += row[c];
+            num += (GrayInMat.cols - Step / 2 + Step - 1) / Step;
+        }
+        return num > 0 ? static_cast<double>(sum) / num : cv::mean(GrayInMat)[0];
+    }
+
+    // 线性 RGB 与亮度均以 12 位定点表示, 权重为 Q15
+    constexpr int LINEAR_BITS = 12;
+    constexpr int LINEAR_MAX = (1 << LINEAR_BITS) - 1;
+    constexpr int WEIGHT_SHIFT = 15;
+
+    /// @brief 定点颜色转换表, 进程内只构建一次; 与 cv::COLOR_BGR2Lab 一样使用 sRGB 伽马与 D65 白点
+    struct LAB_TABLES
+    {
+        ushort toLinear[256];            // sRGB -> 线性
+        uchar toSRGB[LINEAR_MAX + 1];    // 线性 -> sRGB
+        uchar toLightness[LINEAR_MAX + 1]; // 线性亮度 Y -> L * 255 / 100
+        ushort fromLightness[256];       // L * 255 / 100 -> 线性亮度 Y
+        int weightR, weightG, weightB;   // Y = 0.212671 R + 0.715160 G + 0.072169 B
+
+        LAB_TABLES()
+        {
+            for (int i = 0; i < 256; i++)
+            {
+                double v = i / 255.0;
+                v = (v <= 0.04045) ? v / 12.92 : std::pow((v + 0.055) / 1.055, 2.4);
+                toLinear[i] = static_cast<ushort>(cvRound(v * LINEAR_MAX));
+            }
+            for (int i = 0; i <= LINEAR_MAX; i++)
+            {
+                double v = static_cast<double>(i) / LINEAR_MAX;
+                double srgb = (v <= 0.0031308) ? v * 12.92 : 1.055 * std::pow(v, 1.0 / 2.4) - 0.055;
+                toSRGB[i] = cv::saturate_cast<uchar>(srgb * 255.0);
+                double l = (v > 0.008856) ? 116.0 * std::cbrt(v) - 16.0 : 903.3 * v;
+                toLightness[i] = cv::saturate_cast<uchar>(l * 255.0 / 100.0);
+            }
+            for (int i = 0; i < 256; i++)
+            {
+                double l = i * 100.0 / 255.0;
+                double y = (l > 8.0) ? std::pow((l + 16.0) / 116.0, 3.0) : l / 903.3;
+                fromLightness[i] = static_cast<ushort>(std::min(cvRound(y * LINEAR_MAX), LINEAR_MAX));
+            }
+            weightR = cvRound(0.212671 * (1 << WEIGHT_SHIFT));
+            weightG = cvRound(0.715160 * (1 << WEIGHT_SHIFT));
+            weightB = (1 << WEIGHT_SHIFT) - weightR - weightG;
+        }
+    };
+
+    const LAB_TABLES &getLabTables()
+    {
+        static const LAB_TABLES tables;
+        return tables;
+    }
+} // namespace
+
+pcv::AutoGammaStream::AutoGammaStream(float C, float Alpha, int SampleStep, float GammaStep)
+    : m_c(C), m_alpha(Alpha), m_sampleStep(std::max(SampleStep, 1)), m_gammaStep(GammaStep)
+{
+    assert(C > 0 && C < 1 && "C must be in the range (0, 1)");
+    assert(Alpha > 0 && Alpha <= 1 && "Alpha must be in the range (0, 1]");
+    assert(GammaStep > 0 && "GammaStep must be positive");
+}
+/// @brief 清除平滑状态与缓存, 用于切换视频源
+void pcv::AutoGammaStream::reset()
+{
+    this->m_gamma = 1.0f;
+    this->m_hasGamma = false;
+    this->m_lutKey = -1;
+}
+/// @brief 估计当前帧的平均灰度并校正
+/// @param GrayInMat 输入灰度图像
+/// @param OutMat 输出图像, 尺寸类型匹配时复用其内存
+void pcv::AutoGammaStream::apply(const cv::Mat &GrayInMat, cv::Mat &OutMat)
+{
+    assert(!GrayInMat.empty() && "Input image is empty");
+    assert(GrayInMat.type() == CV_8UC1 && "Input image must be a grayscale image");
+    update(sampleMean(GrayInMat, this->m_sampleStep), GrayInMat, OutMat);
+}
+/// @brief 使用已有统计量的均值并校正
+/// @param GrayInMat 输入灰度图像
+/// @param OutMat 输出图像, 尺寸类型匹配时复用其内存
+/// @param Stats GrayInMat 的统计量
+void pcv::AutoGammaStream::apply(const cv::Mat &GrayInMat, cv::Mat &OutMat, const ImageStats &Stats)
+{
+    assert(!GrayInMat.empty() && "Input image is empty");
+    assert(GrayInMat.type() == CV_8UC1 && "Input image must be a grayscale image");
+    assert(!Stats.empty() && "Stats is empty");
+    update(Stats.getMean(), GrayInMat, OutMat);
+}
+/// @brief 平滑伽马值, 量化值变化时重建查找表, 然后查表
+void pcv::AutoGammaStream::update(double MeanGray, const cv::Mat &GrayInMat, cv::Mat &OutMat)
+{
+    // 全黑或全白帧的伽马值无定义, 均值限制在 (0, 255) 内
+    double mean = std::min(std::max(MeanGray, 0.5), 254.5);
+    float gamma = static_cast<float>(std::log10(1 - this->m_c) / std::log10(1 - mean / 255.0)); // 与 autoGammaImage 相同
+    this->m_gamma = this->m_hasGamma ? this->m_alpha * gamma + (1 - this->m_alpha) * this->m_gamma : gamma;
+    this->m_hasGamma = true;
+
+    int key = std::max(cvRound(this->m_gamma / this->m_gammaStep), 1);
+    if (key != this->m_lutKey)
+    {
+        float quantized = key * this->m_gammaStep;
+        this->m_lut.create(1, 256, CV_8UC1);
+        uchar *lut = this->m_lut.ptr<uchar>();
+        for (int i = 0; i < 256; ++i)
+            lut[i] = cv::saturate_cast<uchar>(std::pow(static_cast<float>(i) / 255.0f, 1.0f / quantized) * 255.0f);
+        this->m_lutKey = key;
+    }
+    cv::LUT(GrayInMat, this->m_lut, OutMat);
+}
+
+pcv::ColorEqualizer::ColorEqualizer(double ClipLimit, const cv::Size &TileGridSize)
+    : m_clahe(cv::createCLAHE(ClipLimit, TileGridSize))
+{
+}
+/// @brief 设置剪切限制
+void pcv::ColorEqualizer::setClipLimit(double ClipLimit)
+{
+    this->m_clahe->setClipLimit(ClipLimit);
+}
+/// @brief 均衡 BGR 图像
+/// @param InMat 输入图像(CV_8UC3, BGR)
+/// @param OutMat 输出图像, 尺寸类型匹配时复用其内存; 可与 InMat 相同
+void pcv::ColorEqualizer::apply(const cv::Mat &InMat, cv::Mat &OutMat)
+{
+    assert(!InMat.empty() && "Input image is empty");
+    if (InMat.type() != CV_8UC3)
+    {
+        CV_Error(cv::Error::StsBadArg, "输入的InMat不是8位BGR图像。");
+    }
+    const LAB_TABLES &tables = getLabTables();
+    cv::Mat src = InMat;
+    this->m_lightness.create(src.size(), CV_8UC1);
+    this->m_luminance.create(src.size(), CV_16UC1);
+
+    // Step 1: 定点计算线性亮度 Y 与 L 通道
+    cv::parallel_for_(cv::Range(0, src.rows), [&](const cv::Range &range) {
+        for (int r = range.start; r < range.end; r++)
+        {
+            const uchar *in = src.ptr<uchar>(r);
+            ushort *luminance = this->m_luminance.ptr<ushort>(r);
+            uchar *lightness = this->m_lightness.ptr<uchar>(r);
+            for (int c = 0; c < src.cols; c++, in += 3)
+            {
+                int y = (tables.weightB * tables.toLinear[in[0]] + tables.weightG * tables.toLinear[in[1]] +
+                         tables.weightR * tables.toLinear[in[2]] + (1 << (WEIGHT_SHIFT - 1))) >> WEIGHT_SHIFT;
+                luminance[c] = static_cast<ushort>(y);
+                lightness[c] = tables.toLightness[y];
+            }
+        }
+    });
+
+    // Step 2: L 通道 CLAHE
+    this->m_clahe->apply(this->m_lightness, this->m_equalized);
+
+    // Step 3: 线性 RGB 按亮度比例缩放, 色度不变
+    OutMat.create(src.size(), CV_8UC3);
+    cv::parallel_for_(cv::Range(0, src.rows), [&](const cv::Range &range) {
+        for (int r = range.start; r < range.end; r++)
+        {
+            const uchar *in = src.ptr<uchar>(r);
+            uchar *out = OutMat.ptr<uchar>(r);
+            const ushort *luminance = this->m_luminance.ptr<ushort>(r);
+            const uchar *equalized = this->m_equalized.ptr<uchar>(r);
+            for (int c = 0; c < src.cols; c++, in += 3, out += 3)
+            {
+                int y = luminance[c];
+                int target = tables.fromLightness[equalized[c]];
+                if (y == 0)
+                {
+                    // 黑色像素没有色度, 输出灰色
+                    out[0] = out[1] = out[2] = tables.toSRGB[target];
+                    continue;
+                }
+                int64 ratio = (static_cast<int64>(target) << 16) / y; // Q16
+                for (int k = 0; k < 3; k++)
+                {
+                    int64 v = (tables.toLinear[in[k]] * ratio + (1 << 15)) >> 16;
+                    out[k] = tables.toSRGB[std::min<int64>(v, LINEAR_MAX)];
+                }
+            }
+        }
+    });
+}
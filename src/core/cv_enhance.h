@@ -0,0 +1,61 @@
+#ifndef H_PCV_ENHANCE
+#define H_PCV_ENHANCE
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+#include "cv_stats.h"
+
+namespace pcv
+{
+    /// @brief 视频流自动伽马校正
+    /// 伽马值按帧指数平滑以抑制闪烁; 查找表按量化后的伽马缓存, 量化值不变时不重建,
+    /// 每帧的开销约为一次均值估计加一次查表。
+    class AutoGammaStream
+    {
+    public:
+        /// @param C 目标平均灰度值[0-1]
+        /// @param Alpha 平滑系数 (0, 1], 越大越快跟随当前帧, 1 为不平滑
+        /// @param SampleStep 估计均值时的采样间隔 (行列相同), 1 为逐像素
+        /// @param GammaStep 伽马值的量化步长, 决定查找表的重建频率
+        explicit AutoGammaStream(float C, float Alpha = 0.2f, int SampleStep = 4, float GammaStep = 0.01f);
+
+        void apply(const cv::Mat &GrayInMat, cv::Mat &OutMat);                            // 估计均值并校正
+        void apply(const cv::Mat &GrayInMat, cv::Mat &OutMat, const ImageStats &Stats);   // 使用已有统计量的均值并校正
+        void reset();                                                                     // 清除平滑状态与缓存
+        float getGamma() const { return this->m_gamma; }                                  // 当前平滑后的伽马值
+        const cv::Mat &getLut() const { return this->m_lut; }                             // 当前查找表
+
+    private:
+        void update(double MeanGray, const cv::Mat &GrayInMat, cv::Mat &OutMat);
+
+        float m_c;
+        float m_alpha;
+        int m_sampleStep;
+        float m_gammaStep;
+        float m_gamma = 1.0f;    // 平滑后的伽马值
+        bool m_hasGamma = false; // 是否已有平滑状态
+        int m_lutKey = -1;       // 当前查找表对应的量化伽马值, -1 表示尚未生成
+        cv::Mat m_lut;           // 1x256, CV_8UC1
+    };
+
+    /// @brief 可复用的彩色图像直方图均衡 (Lab 空间 L 通道 CLAHE)
+    /// 保存 CLAHE 对象和中间缓冲, 只以定点运算计算亮度通道; 均衡后按亮度比例缩放线性 RGB,
+    /// 色度保持不变, 不经过完整的三通道 Lab 转换。结果与 equalizeColor 相近但不逐像素相同。
+    /// 分块直方图统计与裁剪由 cv::CLAHE 按块并行完成。
+    class ColorEqualizer
+    {
+    public:
+        explicit ColorEqualizer(double ClipLimit = 2.0, const cv::Size &TileGridSize = cv::Size(8, 8));
+
+        void setClipLimit(double ClipLimit);                            // 设置剪切限制
+        void apply(const cv::Mat &InMat, cv::Mat &OutMat);              // 均衡 BGR 图像, OutMat 可与 InMat 相同
+        const cv::Mat &getLightness() const { return this->m_lightness; } // 最近一帧的 L 通道 (0-255)
+
+    private:
+        cv::Ptr<cv::CLAHE> m_clahe;
+        cv::Mat m_lightness; // L 通道
+        cv::Mat m_equalized; // 均衡后的 L 通道
+        cv::Mat m_luminance; // 线性亮度 Y (定点, CV_16UC1)
+    };
+}; // namespace pcv
+#endif // H_PCV_ENHANCE
@@ -0,0 +1,114 @@
+#include "cv_gabor.h"
+#include <cassert>
+#include <opencv2/imgproc.hpp>
+
+pcv::GaborBank::GaborBank(int KernelSize, double Sigma, int OrientationNum, const std::vector<double> &Lambdas,
+                          double Gamma, double Psi, int FftMinKernelSize)
+    : m_orientationNum(OrientationNum), m_fftMinKernelSize(FftMinKernelSize), m_lambdas(Lambdas)
+{
+    if (KernelSize <= 0 || OrientationNum <= 0 || Lambdas.empty())
+    {
+        CV_Error(cv::Error::StsBadArg, "KernelSize与OrientationNum必须为正数, Lambdas不能为空。");
+    }
+    for (double lambda : this->m_lambdas)
+    {
+        for (int n = 0; n < OrientationNum; n++)
+        {
+            this->m_kernels.push_back(cv::getGaborKernel(cv::Size(KernelSize, KernelSize), Sigma, getTheta(n),
+                                                         lambda, Gamma, Psi, CV_32F));
+        }
+    }
+}
+/// @brief 获取第 Lambda 个波长, 第 Orientation 个方向的核
+const cv::Mat &pcv::GaborBank::getKernel(int Lambda, int Orientation) const
+{
+    return this->m_kernels.at(Lambda * this->m_orientationNum + Orientation);
+}
+/// @brief 计算各核在 DftSize 下的频谱; 尺寸不变时沿用缓存
+/// 相关运算等于与翻转核卷积, 因此缓存翻转核的频谱
+void pcv::GaborBank::prepareSpectrums(const cv::Size &DftSize)
+{
+    if (DftSize == this->m_dftSize && this->m_spectrums.size() == this->m_kernels.size())
+        return;
+    this->m_spectrums.resize(this->m_kernels.size());
+    cv::parallel_for_(cv::Range(0, static_cast<int>(this->m_kernels.size())), [&](const cv::Range &range) {
+        for (int i = range.start; i < range.end; i++)
+        {
+            const cv::Mat &kernel = this->m_kernels[i];
+            cv::Mat padded = cv::Mat::zeros(DftSize, CV_32F);
+            cv::flip(kernel, padded(cv::Rect(0, 0, kernel.cols, kernel.rows)), -1);
+            cv::dft(padded, this->m_spectrums[i]);
+        }
+    });
+    this->m_dftSize = DftSize;
+}
+/// @brief 计算全部响应
+/// @param GrayInMat 输入灰度图像 (单通道, 任意深度)
+/// @param OutResponses 输出响应(CV_32FC1), 下标为 Lambda * N + Orientation; 尺寸匹配时复用其内存
+void pcv::GaborBank::apply(const cv::Mat &GrayInMat, std::vector<cv::Mat> &OutResponses)
+{
+    assert(!GrayInMat.empty() && "Input image is empty");
+    assert(GrayInMat.channels() == 1 && "Input image must be a grayscale image");
+
+    const int kernelNum = static_cast<int>(this->m_kernels.size());
+    const cv::Mat &first = this->m_kernels.front();
+    OutResponses.resize(kernelNum);
+
+    if (first.cols < this->m_fftMinKernelSize)
+    {
+        // 小核直接空间域滤波
+        cv::Mat src;
+        GrayInMat.convertTo(src, CV_32F);
+        cv::parallel_for_(cv::Range(0, kernelNum), [&](const cv::Range &range) {
+            for (int i = range.start; i < range.end; i++)
+                cv::filter2D(src, OutResponses[i], CV_32F, this->m_kernels[i]);
+        });
+        return;
+    }
+
+    // 以 BORDER_REFLECT_101 扩边后做线性卷积, 扩边后的尺寸不超过 DFT 尺寸即不发生循环混叠
+    const int rx = first.cols / 2, ry = first.rows / 2;
+    cv::Mat src;
+    GrayInMat.convertTo(src, CV_32F);
+    cv::Size paddedSize(GrayInMat.cols + 2 * rx, GrayInMat.rows + 2 * ry);
+    cv::Size dftSize(cv::getOptimalDFTSize(paddedSize.width), cv::getOptimalDFTSize(paddedSize.height));
+    prepareSpectrums(dftSize);
+
+    this->m_padded.create(dftSize, CV_32F);
+    this->m_padded.setTo(cv::Scalar::all(0));
+    cv::copyMakeBorder(src, this->m_padded(cv::Rect(cv::Point(0, 0), paddedSize)), ry, ry, rx, rx, cv::BORDER_REFLECT_101);
+    cv::dft(this->m_padded, this->m_spectrum);
+
+    const cv::Rect valid(first.cols - 1, first.rows - 1, GrayInMat.cols, GrayInMat.rows);
+    cv::parallel_for_(cv::Range(0, kernelNum), [&](const cv::Range &range) {
+        cv::Mat product, response;
+        for (int i = range.start; i < range.end; i++)
+        {
+            cv::mulSpectrums(this->m_spectrum, this->m_spectrums[i], product, 0);
+            cv::dft(product, response, cv::DFT_INVERSE | cv::DFT_SCALE | cv::DFT_REAL_OUTPUT);
+            response(valid).copyTo(OutResponses[i]);
+        }
+    });
+}
+/// @brief 计算各波长在所有方向上的最大响应幅值
+/// @param GrayInMat 输入灰度图像 (单通道, 任意深度)
+/// @param OutMat 输出能量图(CV_32FC(M)), 第 m 通道对应第 m 个波长
+void pcv::GaborBank::applyMaxEnergy(const cv::Mat &GrayInMat, cv::Mat &OutMat)
+{
+    std::vector<cv::Mat> responses;
+    apply(GrayInMat, responses);
+
+    const int lambdaNum = getLambdaNum();
+    std::vector<cv::Mat> energies(lambdaNum);
+    for (int m = 0; m < lambdaNum; m++)
+    {
+        cv::Mat magnitude;
+        energies[m] = cv::abs(responses[m * this->m_orientationNum]);
+        for (int n = 1; n < this->m_orientationNum; n++)
+        {
+            magnitude = cv::abs(responses[m * this->m_orientationNum + n]);
+            cv::max(energies[m], magnitude, energies[m]);
+        }
+    }
+    cv::merge(energies, OutMat);
+}
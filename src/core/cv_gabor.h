@@ -0,0 +1,47 @@
+#ifndef H_PCV_GABOR
+#define H_PCV_GABOR
+
+#include <vector>
+#include <opencv2/core.hpp>
+
+namespace pcv
+{
+    /// @brief Gabor 滤波器组
+    /// 构造时为 N 个方向 x M 个波长预计算核; 核较大时输入图像只做一次 FFT,
+    /// 每个核的响应只需一次频域相乘和逆变换, 核的频谱按图像尺寸缓存。
+    /// 响应与 cv::filter2D (BORDER_REFLECT_101) 的结果一致, 不做归一化。
+    class GaborBank
+    {
+    public:
+        /// @param KernelSize 核大小
+        /// @param Sigma 核的标准差
+        /// @param OrientationNum 方向数 N, 方向为 pi * n / N
+        /// @param Lambdas 波长列表 (M 个)
+        /// @param Gamma 空间纵横比
+        /// @param Psi 相位偏移
+        /// @param FftMinKernelSize 核大小不小于该值时使用 FFT, 否则空间域滤波
+        GaborBank(int KernelSize, double Sigma, int OrientationNum, const std::vector<double> &Lambdas,
+                  double Gamma = 0.5, double Psi = CV_PI * 0.5, int FftMinKernelSize = 15);
+
+        int getOrientationNum() const { return this->m_orientationNum; }
+        int getLambdaNum() const { return static_cast<int>(this->m_lambdas.size()); }
+        double getTheta(int Orientation) const { return CV_PI * Orientation / this->m_orientationNum; }
+        const cv::Mat &getKernel(int Lambda, int Orientation) const;                  // 第 Lambda 个波长, 第 Orientation 个方向的核
+
+        void apply(const cv::Mat &GrayInMat, std::vector<cv::Mat> &OutResponses);      // 全部响应(CV_32FC1), 下标为 Lambda * N + Orientation
+        void applyMaxEnergy(const cv::Mat &GrayInMat, cv::Mat &OutMat);                // 各波长在所有方向上的最大响应幅值(CV_32FC(M))
+
+    private:
+        void prepareSpectrums(const cv::Size &DftSize);
+
+        int m_orientationNum;
+        int m_fftMinKernelSize;
+        std::vector<double> m_lambdas;
+        std::vector<cv::Mat> m_kernels;   // 下标为 Lambda * N + Orientation
+        cv::Size m_dftSize;               // 当前频谱缓存对应的 DFT 尺寸
+        std::vector<cv::Mat> m_spectrums; // 翻转后的核在 m_dftSize 下的频谱 (CCS 格式)
+        cv::Mat m_padded;                 // 输入的扩边与频谱缓冲
+        cv::Mat m_spectrum;
+    };
+}; // namespace pcv
+#endif // H_PCV_GABOR
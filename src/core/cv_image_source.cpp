@@ -0,0 +1,186 @@
+#include "cv_image_source.h"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+namespace
+{
+    /// @brief 读取整个文件
+    bool readFile(const std::string &Path, std::vector<uchar> &OutBytes)
+    {
+        std::ifstream file(Path, std::ios::binary | std::ios::ate);
+        if (!file)
+            return false;
+        std::streamsize size = file.tellg();
+        if (size <= 0)
+            return false;
+        OutBytes.resize(static_cast<size_t>(size));
+        file.seekg(0, std::ios::beg);
+        return static_cast<bool>(file.read(reinterpret_cast<char *>(OutBytes.data()), size));
+    }
+} // namespace
+
+pcv::ImageSource::ImageSource(const std::vector<std::string> &Paths, const IMAGE_SOURCE_PARAM &Param)
+    : m_paths(Paths), m_param(Param)
+{
+    start();
+}
+/// @param Directory 目录
+/// @param Pattern 文件名通配符, 如 "*.jpg"
+pcv::ImageSource::ImageSource(const std::string &Directory, const std::string &Pattern, const IMAGE_SOURCE_PARAM &Param)
+    : m_param(Param)
+{
+    cv::glob(Directory + "/" + Pattern, m_paths, false);
+    std::sort(m_paths.begin(), m_paths.end());
+    start();
+}
+pcv::ImageSource::~ImageSource()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_windowCond.notify_all();
+    m_readyCond.notify_all();
+    for (std::thread &worker : m_workers)
+    {
+        if (worker.joinable())
+            worker.join();
+    }
+}
+void pcv::ImageSource::start()
+{
+    if (m_param.QueueSize <= 0)
+    {
+        CV_Error(cv::Error::StsBadArg, "QueueSize必须为正数。");
+    }
+    int threadNum = m_param.ThreadNum > 0 ? m_param.ThreadNum : std::max(1, cv::getNumThreads());
+    threadNum = std::min(threadNum, std::max(1, static_cast<int>(m_paths.size())));
+    for (int i = 0; i < threadNum; i++)
+    {
+        m_workers.emplace_back(&ImageSource::workerLoop, this);
+    }
+}
+/// @brief 从归还的图像中取一块内存, 供 imdecode 复用
+cv::Mat pcv::ImageSource::acquireBuffer()
+{
+    std::lock_guard<std::mutex> lock(m_poolMutex);
+    if (m_pool.empty())
+        return cv::Mat();
+    cv::Mat buffer = std::move(m_pool.back());
+    m_pool.pop_back();
+    return buffer;
+}
+/// @brief 解码线程: 领取窗口内的下一个序号, 读取并解码
+void pcv::ImageSource::workerLoop()
+{
+    std::vector<uchar> bytes; // 文件内容, 同一线程内复用
+    const int total = static_cast<int>(m_paths.size());
+    while (true)
+    {
+        int index;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            // 领取的序号不超过已取走数量 + QueueSize, 限制内存占用
+            m_windowCond.wait(lock, [&]() {
+                return m_stop || m_claimed >= total || m_claimed < m_consumed + m_param.QueueSize;
+            });
+            if (m_stop || m_claimed >= total)
+                return;
+            index = m_claimed++;
+        }
+
+        cv::Mat image = acquireBuffer();
+        bool decoded = false;
+        try
+        {
+            // 尺寸类型相同时 imdecode 直接写入 image 的内存; 失败时 image 保留旧内容, 需置空
+            decoded = readFile(m_paths[index], bytes) && !cv::imdecode(bytes, m_param.Flags, &image).empty();
+        }
+        catch (const cv::Exception &)
+        {
+            decoded = false;
+        }
+        if (!decoded)
+            image.release();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_ready.emplace(index, std::move(image));
+        }
+        m_readyCond.notify_all();
+    }
+}
+/// @brief 取下一张图像, 没有解码完成时阻塞等待
+/// @param OutMat 输出图像, 解码失败时为空
+/// @param OutIndex 非空时输出图像在列表中的序号
+/// @return 全部取完时返回 false
+bool pcv::ImageSource::next(cv::Mat &OutMat, int *OutIndex)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_consumed >= static_cast<int>(m_paths.size()))
+    {
+        OutMat.release();
+        return false;
+    }
+    std::map<int, cv::Mat>::iterator it;
+    m_readyCond.wait(lock, [&]() {
+        it = m_param.Ordered ? m_ready.find(m_nextIndex) : m_ready.begin();
+        return it != m_ready.end();
+    });
+    int index = it->first;
+    OutMat = std::move(it->second);
+    m_ready.erase(it);
+    m_consumed++;
+    if (m_param.Ordered)
+        m_nextIndex++;
+    lock.unlock();
+    m_windowCond.notify_all();
+    if (OutIndex != nullptr)
+        *OutIndex = index;
+    return true;
+}
+/// @brief 归还图像内存; 仍被其他 Mat 引用或为子矩阵时直接释放
+void pcv::ImageSource::recycle(cv::Mat &Buffer)
+{
+    if (Buffer.empty() || !Buffer.u || Buffer.u->refcount != 1 || !Buffer.isContinuous() ||
+        Buffer.datastart != Buffer.data)
+    {
+        Buffer.release();
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_poolMutex);
+    if (static_cast<int>(m_pool.size()) < m_param.QueueSize)
+        m_pool.push_back(std::move(Buffer));
+    Buffer.release();
+}
+/// @brief 生成缩小解码标志
+/// @param Flags IMREAD_COLOR 或 IMREAD_GRAYSCALE
+/// @param Factor 缩小倍数, 1, 2, 4 或 8
+int pcv::ImageSource::getReducedFlags(int Flags, int Factor)
+{
+    const bool gray = (Flags == cv::IMREAD_GRAYSCALE);
+    switch (Factor)
+    {
+    case 1:
+        return Flags;
+    case 2:
+        return gray ? cv::IMREAD_REDUCED_GRAYSCALE_2 : cv::IMREAD_REDUCED_COLOR_2;
+    case 4:
+        return gray ? cv::IMREAD_REDUCED_GRAYSCALE_4 : cv::IMREAD_REDUCED_COLOR_4;
+    case 8:
+        return gray ? cv::IMREAD_REDUCED_GRAYSCALE_8 : cv::IMREAD_REDUCED_COLOR_8;
+    default:
+        CV_Error(cv::Error::StsBadArg, "Factor必须为1, 2, 4或8。");
+    }
+}
+/// @brief 缩小解码后各边仍不小于 TargetSize 的最大倍数, 如后续 pcv::resize 的目标尺寸
+int pcv::ImageSource::getReduceFactor(const cv::Size &ImageSize, const cv::Size &TargetSize)
+{
+    for (int factor = 8; factor > 1; factor /= 2)
+    {
+        if (ImageSize.width / factor >= TargetSize.width && ImageSize.height / factor >= TargetSize.height)
+            return factor;
+    }
+    return 1;
+}
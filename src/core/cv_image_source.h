@@ -0,0 +1,67 @@
+#ifndef H_PCV_IMAGE_SOURCE
+#define H_PCV_IMAGE_SOURCE
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <opencv2/core.hpp>
+#include <opencv2/imgcodecs.hpp>
+
+namespace pcv
+{
+    /// @brief 预读参数
+    struct IMAGE_SOURCE_PARAM
+    {
+        int ThreadNum = 0;                // 解码线程数, 非正数时取 cv::getNumThreads()
+        int QueueSize = 16;               // 已解码及正在解码的图像数上限
+        bool Ordered = true;              // 按输入顺序输出, 否则按解码完成顺序输出
+        int Flags = cv::IMREAD_COLOR;     // cv::imread 标志, 可为 IMREAD_REDUCED_*
+    };
+
+    /// @brief 多线程预读图像源
+    /// 解码线程提前读取并解码后续图像, 放入有界队列; 消费者用 next 依次取出。
+    /// 用 recycle 归还的图像会被解码线程复用, 尺寸类型相同时不再分配内存。
+    class ImageSource
+    {
+    public:
+        ImageSource(const std::vector<std::string> &Paths, const IMAGE_SOURCE_PARAM &Param = IMAGE_SOURCE_PARAM());
+        ImageSource(const std::string &Directory, const std::string &Pattern,
+                    const IMAGE_SOURCE_PARAM &Param = IMAGE_SOURCE_PARAM());                 // 目录下匹配 Pattern 的文件 (按文件名排序)
+        ~ImageSource();
+        ImageSource(const ImageSource &) = delete;
+        ImageSource &operator=(const ImageSource &) = delete;
+
+        bool next(cv::Mat &OutMat, int *OutIndex = nullptr);   // 取下一张图像, 全部取完返回 false; 解码失败时 OutMat 为空
+        void recycle(cv::Mat &Buffer);                          // 归还图像内存, Buffer 随后被置空
+        size_t size() const { return m_paths.size(); }
+        const std::string &getPath(int Index) const { return m_paths[Index]; }
+
+        static int getReducedFlags(int Flags, int Factor);                                 // 按缩小倍数 (1, 2, 4, 8) 生成 IMREAD_REDUCED_* 标志
+        static int getReduceFactor(const cv::Size &ImageSize, const cv::Size &TargetSize); // 缩小后不小于 TargetSize 的最大倍数
+
+    private:
+        void start();
+        void workerLoop();
+        cv::Mat acquireBuffer();
+
+        std::vector<std::string> m_paths;
+        IMAGE_SOURCE_PARAM m_param;
+        std::vector<std::thread> m_workers;
+
+        std::mutex m_mutex;
+        std::condition_variable m_readyCond;  // 有新的解码结果
+        std::condition_variable m_windowCond; // 消费者取走图像, 解码窗口前移
+        std::map<int, cv::Mat> m_ready;       // 已解码, 按序号
+        int m_claimed = 0;                    // 下一张待解码的序号
+        int m_consumed = 0;                   // 已取走的数量
+        int m_nextIndex = 0;                  // 有序输出时下一张的序号
+        bool m_stop = false;
+
+        std::mutex m_poolMutex;
+        std::vector<cv::Mat> m_pool;          // 归还的图像内存
+    };
+}; // namespace pcv
+#endif // H_PCV_IMAGE_SOURCE
@@ -0,0 +1,326 @@
+#include "cv_labeling.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <opencv2/core.hpp>
+
+namespace
+{
+    /// @brief 无锁并查集 (根节点总是挂到下标更小的根上, 因此集合的根即光栅顺序上的第一个元素)
+    class AtomicUnionFind
+    {
+    public:
+        explicit AtomicUnionFind(int Num) : m_parent(new std::atomic<int>[Num])
+        {
+            for (int i = 0; i < Num; i++)
+            {
+                m_parent[i].store(i, std::memory_order_relaxed);
+            }
+        }
+        /// @brief 查找根节点 (路径减半)
+        int find(int X)
+        {
+            while (true)
+            {
+                int parent = m_parent[X].load(std::memory_order_acquire);
+                if (parent == X)
+                    return X;
+                int grand = m_parent[parent].load(std::memory_order_acquire);
+                if (grand != parent)
+                    m_parent[X].compare_exchange_weak(parent, grand, std::memory_order_acq_rel);
+                X = grand;
+            }
+        }
+        /// @brief 合并两个集合
+        void unite(int A, int B)
+        {
+            while (true)
+            {
+                A = find(A);
+                B = find(B);
+                if (A == B)
+                    return;
+                if (A > B)
+                    std::swap(A, B);
+                int expected = B;
+                if (m_parent[B].compare_exchange_strong(expected, A, std::memory_order_acq_rel))
+                    return;
+            }
+        }
+
+    private:
+        std::unique_ptr<std::atomic<int>[]> m_parent;
+    };
+
+    /// @brief 水平条带: 条带内的游程以及每行游程的起始下标
+    struct STRIPE
+    {
+        int rowBegin = 0;
+        int rowEnd = 0;
+        int offset = 0;            // 条带首个游程的全局下标
+        std::vector<pcv::RUN> runs;
+        std::vector<int> rowStart; // 第 r 行游程为 [rowStart[r - rowBegin], rowStart[r - rowBegin + 1])
+    };
+
+    /// @brief 提取条带内的前景游程
+    void extractStripeRuns(const cv::Mat &ThresMat, STRIPE &Stripe)
+    {
+        Stripe.runs.clear();
+        Stripe.rowStart.assign(Stripe.rowEnd - Stripe.rowBegin + 1, 0);
+        for (int r = Stripe.rowBegin; r < Stripe.rowEnd; r++)
+        {
+            Stripe.rowStart[r - Stripe.rowBegin] = static_cast<int>(Stripe.runs.size());
+            const uchar *row = ThresMat.ptr<uchar>(r);
+            int c = 0;
+            while (c < ThresMat.cols)
+            {
+                if (row[c] == 0)
+                {
+                    c++;
+                    continue;
+                }
+                int start = c;
+                while (c + 1 < ThresMat.cols && row[c + 1] != 0)
+                    c++;
+                Stripe.runs.push_back({r, start, c});
+                c++;
+            }
+        }
+        Stripe.rowStart.back() = static_cast<int>(Stripe.runs.size());
+    }
+
+    /// @brief 合并上下相邻两行中连通的游程
+    /// @param Prev 上一行游程, 全局下标从 PrevBase 开始
+    /// @param Cur 当前行游程, 全局下标从 CurBase 开始
+    /// @param Gap 8 连通时为 1 (对角相邻也连通), 4 连通时为 0
+    void uniteAdjacentRows(const pcv::RUN *Prev, int PrevBase, int PrevNum,
+                           const pcv::RUN *Cur, int CurBase, int CurNum,
+                           AtomicUnionFind &UnionFind, int Gap = 1)
+    {
+        int i = 0, j = 0;
+        while (i < PrevNum && j < CurNum)
+        {
+            const pcv::RUN &p = Prev[i];
+            const pcv::RUN &c = Cur[j];
+            if (p.colEnd + Gap < c.colStart)
+            {
+                i++;
+                continue;
+            }
+            if (c.colEnd + Gap < p.colStart)
+            {
+                j++;
+                continue;
+            }
+            UnionFind.unite(PrevBase + i, CurBase + j);
+            // 先结束的游程不会再与另一行后续游程相交
+            if (p.colEnd < c.colEnd)
+                i++;
+            else
+                j++;
+        }
+    }
+
+    /// @brief 合并条带中第 Row 行与上一行的游程
+    void uniteRowWithAbove(const STRIPE &Above, const STRIPE &Below, int Row, AtomicUnionFind &UnionFind)
+    {
+        int prevBegin = Above.rowStart[Row - 1 - Above.rowBegin];
+        int prevEnd = Above.rowStart[Row - Above.rowBegin];
+        int curBegin = Below.rowStart[Row - Below.rowBegin];
+        int curEnd = Below.rowStart[Row - Below.rowBegin + 1];
+        uniteAdjacentRows(Above.runs.data() + prevBegin, Above.offset + prevBegin, prevEnd - prevBegin,
+                          Below.runs.data() + curBegin, Below.offset + curBegin, curEnd - curBegin,
+                          UnionFind);
+    }
+} // namespace
+
+/// @brief 多线程分条带连通域分割 (8 连通)
+/// 各水平条带并行提取游程并在条带内合并, 条带边界处的游程通过无锁并查集并行合并,
+/// 最终标签按每个连通域首个像素的光栅顺序编号。
+/// @param ThresMat 输入二值化图像
+/// @param OutRegions 输出连通域集合
+/// @param StripeNum 条带数, 非正数时按线程数自动确定
+/// @return 连通域数量 (含背景, 与 connection 一致)
+int pcv::connectionParallel(const cv::Mat &ThresMat, RegionSet& OutRegions, int StripeNum)
+{
+    OutRegions.clear();
+    if (ThresMat.type() != CV_8UC1)
+    {
+        CV_Error(cv::Error::StsBadArg, "输入的ThresMat不是二值化图像。");
+    }
+    if (ThresMat.empty())
+    {
+        return 1;
+    }
+    if (StripeNum <= 0)
+    {
+        StripeNum = std::max(1, cv::getNumThreads()) * 4;
+    }
+    StripeNum = std::min(StripeNum, ThresMat.rows);
+
+    std::vector<STRIPE> stripes(StripeNum);
+    for (int s = 0; s < StripeNum; s++)
+    {
+        stripes[s].rowBegin = static_cast<int>(static_cast<int64>(ThresMat.rows) * s / StripeNum);
+        stripes[s].rowEnd = static_cast<int>(static_cast<int64>(ThresMat.rows) * (s + 1) / StripeNum);
+    }
+
+    // Step 1: 各条带并行提取游程
+    cv::parallel_for_(cv::Range(0, StripeNum), [&](const cv::Range &range) {
+        for (int s = range.start; s < range.end; s++)
+        {
+            extractStripeRuns(ThresMat, stripes[s]);
+        }
+    });
+
+    int total = 0;
+    for (STRIPE &stripe : stripes)
+    {
+        stripe.offset = total;
+        total += static_cast<int>(stripe.runs.size());
+    }
+    if (total == 0)
+    {
+        return 1;
+    }
+
+    // Step 2: 条带内逐行合并, 并与上一条带的最后一行合并
+    AtomicUnionFind unionFind(total);
+    cv::parallel_for_(cv::Range(0, StripeNum), [&](const cv::Range &range) {
+        for (int s = range.start; s < range.end; s++)
+        {
+            const STRIPE &stripe = stripes[s];
+            for (int r = stripe.rowBegin + 1; r < stripe.rowEnd; r++)
+            {
+                uniteRowWithAbove(stripe, stripe, r, unionFind);
+            }
+            if (s > 0)
+            {
+                uniteRowWithAbove(stripes[s - 1], stripe, stripe.rowBegin, unionFind);
+            }
+        }
+    });
+
+    // Step 3: 按光栅顺序分配最终标签 (集合的根总是集合中下标最小的游程)
+    std::vector<int> labels(total);
+    int labelNum = 1;
+    for (int i = 0; i < total; i++)
+    {
+        int root = unionFind.find(i);
+        labels[i] = (root == i) ? labelNum++ : labels[root];
+    }
+
+    // Step 4: 按标签收集游程, 保持光栅顺序
+    std::vector<int> counts(labelNum, 0);
+    for (int i = 0; i < total; i++)
+    {
+        counts[labels[i]]++;
+    }
+    std::vector<std::vector<RUN>> regionRuns(labelNum);
+    for (int l = 1; l < labelNum; l++)
+    {
+        regionRuns[l].reserve(counts[l]);
+    }
+    for (const STRIPE &stripe : stripes)
+    {
+        for (size_t k = 0; k < stripe.runs.size(); k++)
+        {
+            regionRuns[labels[stripe.offset + k]].push_back(stripe.runs[k]);
+        }
+    }
+
+    OutRegions.reserve(labelNum - 1);
+    for (int l = 1; l < labelNum; l++)
+    {
+        OutRegions.push(l, pcv::Region(std::move(regionRuns[l]), ThresMat.size()));
+    }
+    return labelNum;
+}
+/// @brief 多线程分条带连通域分割 (8 连通)
+/// @param ThresMat 输入二值化图像
+/// @param OutRegions 输出连通域字典
+/// @param StripeNum 条带数, 非正数时按线程数自动确定
+/// @return 连通域数量 (含背景)
+int pcv::connectionParallel(const cv::Mat &ThresMat, std::unordered_map<int, Region>& OutRegions, int StripeNum)
+{
+    OutRegions.clear();
+    RegionSet regions;
+    int labelNum = pcv::connectionParallel(ThresMat, regions, StripeNum);
+    OutRegions.reserve(regions.size());
+    for (size_t i = 0; i < regions.size(); i++)
+    {
+        OutRegions.emplace(regions.getLabel(i), regions.takeRegion(i));
+    }
+    return labelNum;
+}
+/// @brief 游程连通域标记
+/// @param Runs 输入游程, 按 (row, colStart) 升序且互不重叠
+/// @param OutLabels 输出每个游程的标签, 按首个游程的光栅顺序从 1 开始编号
+/// @param Connectivity 连通性 (4 或 8)
+/// @return 标签数 (含背景)
+int pcv::labelRuns(const std::vector<RUN> &Runs, std::vector<int> &OutLabels, int Connectivity)
+{
+    assert((Connectivity == 4 || Connectivity == 8) && "Connectivity must be 4 or 8");
+    int total = static_cast<int>(Runs.size());
+    OutLabels.assign(total, 0);
+    if (total == 0)
+    {
+        return 1;
+    }
+
+    AtomicUnionFind unionFind(total);
+    int gap = (Connectivity == 8) ? 1 : 0;
+    int prevBegin = 0, prevEnd = 0; // 上一行的游程
+    int curBegin = 0;
+    while (curBegin < total)
+    {
+        int curEnd = curBegin;
+        while (curEnd < total && Runs[curEnd].row == Runs[curBegin].row)
+            curEnd++;
+        if (prevEnd > prevBegin && Runs[prevBegin].row + 1 == Runs[curBegin].row)
+        {
+            uniteAdjacentRows(Runs.data() + prevBegin, prevBegin, prevEnd - prevBegin,
+                              Runs.data() + curBegin, curBegin, curEnd - curBegin,
+                              unionFind, gap);
+        }
+        prevBegin = curBegin;
+        prevEnd = curEnd;
+        curBegin = curEnd;
+    }
+
+    int labelNum = 1;
+    for (int i = 0; i < total; i++)
+    {
+        int root = unionFind.find(i);
+        OutLabels[i] = (root == i) ? labelNum++ : OutLabels[root];
+    }
+    return labelNum;
+}
+/// @brief 分割区域的连通域, 直接在游程上标记, 不生成掩膜图像
+/// 标签按首个游程的光栅顺序编号, 与 connection(const cv::Mat &, RegionSet &) 一致
+/// @param InRegion 输入区域, 例如 threshold 输出的区域
+/// @param OutRegions 输出连通域集合
+/// @param Connectivity 连通性 (4 或 8)
+/// @return 连通域数量 (含背景)
+int pcv::connection(const Region &InRegion, RegionSet &OutRegions, int Connectivity)
+{
+    OutRegions.clear();
+    const std::vector<RUN> &runs = InRegion.getRuns();
+    std::vector<int> labels;
+    int labelNum = pcv::labelRuns(runs, labels, Connectivity);
+    if (labelNum > 1)
+    {
+        // 游程按光栅顺序分发, 各连通域内的游程保持有序
+        std::vector<std::vector<RUN>> regionRuns(labelNum);
+        for (size_t i = 0; i < runs.size(); i++)
+        {
+            regionRuns[labels[i]].push_back(runs[i]);
+        }
+        OutRegions.reserve(labelNum - 1);
+        for (int l = 1; l < labelNum; l++)
+        {
+            OutRegions.push(l, pcv::Region(std::move(regionRuns[l]), InRegion.getMatSize()));
+        }
+    }
+    return labelNum;
+}
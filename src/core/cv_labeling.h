@@ -0,0 +1,16 @@
+#ifndef H_PCV_LABELING
+#define H_PCV_LABELING
+
+#include <opencv2/core.hpp>
+#include <unordered_map>
+#include <vector>
+#include "cv_region.h"
+
+namespace pcv
+{
+    int connectionParallel(const cv::Mat &ThresMat, RegionSet& OutRegions, int StripeNum = 0);                      // 多线程分条带分割连通域
+    int connectionParallel(const cv::Mat &ThresMat, std::unordered_map<int, Region>& OutRegions, int StripeNum = 0); // 多线程分条带分割连通域
+    int labelRuns(const std::vector<RUN> &Runs, std::vector<int> &OutLabels, int Connectivity = 8);                 // 游程连通域标记
+    int connection(const Region &InRegion, RegionSet &OutRegions, int Connectivity = 8);                            // 分割区域的连通域, 不生成掩膜
+}; // namespace pcv
+#endif // H_PCV_LABELING
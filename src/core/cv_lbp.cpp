@@ -0,0 +1,577 @@
+#include "cv_lbp.h"
+#include <algorithm>
+#include <bitset>
+#include <cassert>
+#include <cmath>
+#include <vector>
+#include <opencv2/core/hal/intrin.hpp>
+
+namespace
+{
+    /// @brief 8 位循环左移
+    inline uchar rotateLeft(uchar Code, int Shift)
+    {
+        return static_cast<uchar>((Code << Shift) | (Code >> (8 - Shift)));
+    }
+
+    /// @brief 编码中 1 的个数
+    inline int countOnes(uchar Code)
+    {
+        int num = 0;
+        for (; Code; Code &= static_cast<uchar>(Code - 1))
+            num++;
+        return num;
+    }
+
+    /// @brief 编码在循环意义下 0/1 跳变的次数
+    inline int countTransitions(uchar Code)
+    {
+        return countOnes(static_cast<uchar>(Code ^ rotateLeft(Code, 1)));
+    }
+
+    /// @brief 原始编码到各编码类型类别的映射表, 进程内只构建一次
+    struct LBP_TABLES
+    {
+        uchar uniform[256];
+        uchar rotation[256];
+        uchar uniformRotation[256];
+
+        LBP_TABLES()
+        {
+            int uniformNum = 0;
+            for (int code = 0; code < 256; code++)
+            {
+                bool isUniform = countTransitions(static_cast<uchar>(code)) <= 2;
+                uniform[code] = static_cast<uchar>(isUniform ? uniformNum++ : 58);
+                uniformRotation[code] = static_cast<uchar>(isUniform ? countOnes(static_cast<uchar>(code)) : 9);
+            }
+
+            // 旋转不变: 取各循环移位中的最小编码, 再按最小编码升序编号
+            uchar minCode[256];
+            bool used[256] = {false};
+            for (int code = 0; code < 256; code++)
+            {
+                uchar m = static_cast<uchar>(code);
+                for (int s = 1; s < 8; s++)
+                    m = std::min(m, rotateLeft(static_cast<uchar>(code), s));
+                minCode[code] = m;
+                used[m] = true;
+            }
+            uchar index[256] = {0};
+            int rotationNum = 0;
+            for (int code = 0; code < 256; code++)
+            {
+                if (used[code])
+                    index[code] = static_cast<uchar>(rotationNum++);
+            }
+            for (int code = 0; code < 256; code++)
+            {
+                rotation[code] = index[minCode[code]];
+            }
+        }
+    };
+
+    /// @brief 获取编码类型的映射表, 原始编码返回 nullptr
+    const uchar *getLBPTable(pcv::LBP_TYPE Type)
+    {
+        static const LBP_TABLES tables;
+        switch (Type)
+        {
+        case pcv::LBP_TYPE::UNIFORM:
+            return tables.uniform;
+        case pcv::LBP_TYPE::ROTATION_INVARIANT:
+            return tables.rotation;
+        case pcv::LBP_TYPE::UNIFORM_ROTATION_INVARIANT:
+            return tables.uniformRotation;
+        default:
+            return nullptr;
+        }
+    }
+
+    /// @brief 计算一行的原始 LBP 编码, 首尾像素没有完整邻域, 编码为 0
+    /// 比特顺序自左上角顺时针: 左上(7) 上(6) 右上(5) 右(4) 右下(3) 下(2) 左下(1) 左(0)
+    void calcLBPRow(const uchar *Prev, const uchar *Cur, const uchar *Next, uchar *Dst, int Cols)
+    {
+        Dst[0] = 0;
+        Dst[Cols - 1] = 0;
+        int x = 1;
+#if CV_SIMD
+        const int step = cv::v_uint8::nlanes;
+        const cv::v_uint8 b7 = cv::vx_setall_u8(128), b6 = cv::vx_setall_u8(64);
+        const cv::v_uint8 b5 = cv::vx_setall_u8(32), b4 = cv::vx_setall_u8(16);
+        const cv::v_uint8 b3 = cv::vx_setall_u8(8), b2 = cv::vx_setall_u8(4);
+        const cv::v_uint8 b1 = cv::vx_setall_u8(2), b0 = cv::vx_setall_u8(1);
+        for (; x <= Cols - 1 - step; x += step)
+        {
+            cv::v_uint8 c = cv::vx_load(Cur + x);
+            cv::v_uint8 code = (cv::vx_load(Prev + x - 1) >= c) & b7;
+            code = code | ((cv::vx_load(Prev + x) >= c) & b6);
+            code = code | ((cv::vx_load(Prev + x + 1) >= c) & b5);
+            code = code | ((cv::vx_load(Cur + x + 1) >= c) & b4);
+            code = code | ((cv::vx_load(Next + x + 1) >= c) & b3);
+            code = code | ((cv::vx_load(Next + x) >= c) & b2);
+            code = code | ((cv::vx_load(Next + x - 1) >= c) & b1);
+            code = code | ((cv::vx_load(Cur + x - 1) >= c) & b0);
+            cv::v_store(Dst + x, code);
+        }
+#endif
+        for (; x < Cols - 1; x++)
+        {
+            uchar c = Cur[x];
+            Dst[x] = static_cast<uchar>(((Prev[x - 1] >= c) << 7) | ((Prev[x] >= c) << 6) |
+                                        ((Prev[x + 1] >= c) << 5) | ((Cur[x + 1] >= c) << 4) |
+                                        ((Next[x + 1] >= c) << 3) | ((Next[x] >= c) << 2) |
+                                        ((Next[x - 1] >= c) << 1) | ((Cur[x - 1] >= c) << 0));
+        }
+    }
+
+    /// @brief P 位循环左移
+    inline uint32_t rotateLeft(uint32_t Code, int Shift, int Bits)
+    {
+        const uint32_t mask = (1u << Bits) - 1;
+        return ((Code << Shift) | (Code >> (Bits - Shift))) & mask;
+    }
+
+    /// @brief P 位编码映射为等价模式类别:
+    /// 全 0 为 0, k 个连续 1 (1 <= k < P) 起始于第 r 位为 1 + (k - 1) * P + r, 全 1 为 P * (P - 1) + 1, 非等价模式为 P * (P - 1) + 2
+    inline int uniformClass(uint32_t Code, int Bits)
+    {
+        const uint32_t rotated = rotateLeft(Code, 1, Bits);
+        const int ones = static_cast<int>(std::bitset<32>(Code).count());
+        if (std::bitset<32>(Code ^ rotated).count() > 2)
+            return Bits * (Bits - 1) + 2;
+        if (ones == 0)
+            return 0;
+        if (ones == Bits)
+            return Bits * (Bits - 1) + 1;
+        uint32_t start = Code & ~rotated; // 只有连续 1 的起始位为 1
+        int r = 0;
+        while (!(start & 1u))
+        {
+            start >>= 1;
+            r++;
+        }
+        return 1 + (ones - 1) * Bits + r;
+    }
+
+    /// @brief P 位编码映射为旋转不变等价模式 (riu2) 类别: 等价模式为 1 的个数, 非等价模式为 P + 1
+    inline int uniformRotationClass(uint32_t Code, int Bits)
+    {
+        if (std::bitset<32>(Code ^ rotateLeft(Code, 1, Bits)).count() > 2)
+            return Bits + 1;
+        return static_cast<int>(std::bitset<32>(Code).count());
+    }
+
+    void checkGrayInput(const cv::Mat &GrayInMat)
+    {
+        assert(!GrayInMat.empty() && "Input image is empty");
+        if (GrayInMat.type() != CV_8UC1)
+        {
+            CV_Error(cv::Error::StsBadArg, "输入的GrayInMat不是8位灰度图像。");
+        }
+    }
+} // namespace
+
+/// @brief 获取编码类型的类别数
+/// @param Type 编码类型
+/// @return 类别数 (直方图的 bin 数)
+int pcv::getLBPBinNum(LBP_TYPE Type)
+{
+    switch (Type)
+    {
+    case LBP_TYPE::UNIFORM:
+        return 59;
+    case LBP_TYPE::ROTATION_INVARIANT:
+        return 36;
+    case LBP_TYPE::UNIFORM_ROTATION_INVARIANT:
+        return 10;
+    default:
+        return 256;
+    }
+}
+/// @brief 计算 LBP 编码图像
+/// 逐行以 SIMD 同时比较 8 个邻域, 不复制边界; 输出与输入逐像素对齐, 四周一圈像素编码为 0。
+/// @param GrayInMat 输入灰度图像
+/// @param OutMat 输出编码图像(CV_8UC1), 像素值为编码类型下的类别号
+/// @param Type 编码类型
+void pcv::calcLBP(const cv::Mat &GrayInMat, cv::Mat &OutMat, LBP_TYPE Type)
+{
+    checkGrayInput(GrayInMat);
+    cv::Mat src = (OutMat.data == GrayInMat.data) ? GrayInMat.clone() : GrayInMat;
+    OutMat.create(src.size(), CV_8UC1);
+    if (src.rows < 3 || src.cols < 3)
+    {
+        OutMat.setTo(cv::Scalar::all(0));
+        return;
+    }
+
+    const uchar *table = getLBPTable(Type);
+    OutMat.row(0).setTo(cv::Scalar::all(0));
+    OutMat.row(src.rows - 1).setTo(cv::Scalar::all(0));
+    cv::parallel_for_(cv::Range(1, src.rows - 1), [&](const cv::Range &range) {
+        for (int r = range.start; r < range.end; r++)
+        {
+            uchar *dst = OutMat.ptr<uchar>(r);
+            calcLBPRow(src.ptr<uchar>(r - 1), src.ptr<uchar>(r), src.ptr<uchar>(r + 1), dst, src.cols);
+            if (table)
+            {
+                for (int c = 0; c < src.cols; c++)
+                    dst[c] = table[dst[c]];
+            }
+        }
+    });
+}
+/// @brief 计算分块 LBP 直方图, 编码逐行计算后直接累加到所在块的直方图, 不生成编码图像
+/// 图像按 CellSize 划分, 右侧和下方不足一块的部分忽略; 图像四周一圈像素没有完整邻域, 不参与统计。
+/// @param GrayInMat 输入灰度图像
+/// @param OutHist 输出直方图(CV_32FC1), 每行对应一个块 (按行优先顺序), 列数为类别数;
+///                reshape(1, 1) 即得到拼接后的特征向量
+/// @param CellSize 块大小
+/// @param Type 编码类型
+/// @param Normalize 是否将每个块的直方图归一化为和为 1
+void pcv::calcLBPHist(const cv::Mat &GrayInMat, cv::Mat &OutHist, const cv::Size &CellSize, LBP_TYPE Type, bool Normalize)
+{
+    checkGrayInput(GrayInMat);
+    if (CellSize.width <= 0 || CellSize.height <= 0)
+    {
+        CV_Error(cv::Error::StsBadArg, "CellSize必须为正数。");
+    }
+    const int cellsX = GrayInMat.cols / CellSize.width;
+    const int cellsY = GrayInMat.rows / CellSize.height;
+    if (cellsX == 0 || cellsY == 0)
+    {
+        CV_Error(cv::Error::StsBadArg, "输入图像小于CellSize。");
+    }
+
+    const int bins = getLBPBinNum(Type);
+    const uchar *table = getLBPTable(Type);
+    const int rows = GrayInMat.rows;
+    const int cols = GrayInMat.cols;
+    OutHist.create(cellsX * cellsY, bins, CV_32FC1);
+    OutHist.setTo(cv::Scalar::all(0));
+
+    cv::parallel_for_(cv::Range(0, cellsY), [&](const cv::Range &range) {
+        std::vector<uchar> codes(cols);
+        for (int cy = range.start; cy < range.end; cy++)
+        {
+            int rowBegin = std::max(cy * CellSize.height, 1);
+            int rowEnd = std::min((cy + 1) * CellSize.height, rows - 1);
+            for (int r = rowBegin; r < rowEnd; r++)
+            {
+                calcLBPRow(GrayInMat.ptr<uchar>(r - 1), GrayInMat.ptr<uchar>(r), GrayInMat.ptr<uchar>(r + 1),
+                           codes.data(), cols);
+                for (int cx = 0; cx < cellsX; cx++)
+                {
+                    float *hist = OutHist.ptr<float>(cy * cellsX + cx);
+                    int colBegin = std::max(cx * CellSize.width, 1);
+                    int colEnd = std::min((cx + 1) * CellSize.width, cols - 1);
+                    for (int c = colBegin; c < colEnd; c++)
+                        hist[table ? table[codes[c]] : codes[c]] += 1.0f;
+                }
+            }
+            if (Normalize)
+            {
+                for (int cx = 0; cx < cellsX; cx++)
+                {
+                    float *hist = OutHist.ptr<float>(cy * cellsX + cx);
+                    float sum = 0.0f;
+                    for (int b = 0; b < bins; b++)
+                        sum += hist[b];
+                    if (sum > 0)
+                    {
+                        for (int b = 0; b < bins; b++)
+                            hist[b] /= sum;
+                    }
+                }
+            }
+        }
+    });
+}
+
+/// @brief 构造圆形 LBP, 预计算每组 (P, R) 的采样抽头
+/// @param Samplings 采样参数, 如 {{8, 1}, {16, 2}, {24, 3}}
+pcv::CircularLBP::CircularLBP(const std::vector<LBP_SAMPLING> &Samplings)
+{
+    if (Samplings.empty())
+    {
+        CV_Error(cv::Error::StsBadArg, "Samplings不能为空。");
+    }
+    for (const LBP_SAMPLING &sampling : Samplings)
+    {
+        if (sampling.Neighbors < 4 || sampling.Neighbors > 24 || sampling.Radius <= 0)
+        {
+            CV_Error(cv::Error::StsBadArg, "采样点数必须位于[4, 24], 采样半径必须为正数。");
+        }
+        SAMPLER sampler;
+        sampler.Neighbors = sampling.Neighbors;
+        sampler.Border = 0;
+        sampler.RotationNum = 0;
+        for (int p = 0; p < sampling.Neighbors; p++)
+        {
+            double angle = 2.0 * CV_PI * p / sampling.Neighbors;
+            double y = -sampling.Radius * std::sin(angle);
+            double x = sampling.Radius * std::cos(angle);
+            // 消除三角函数的舍入误差, 使轴向采样点落在整数位置上
+            if (std::abs(y - std::round(y)) < 1e-6)
+                y = std::round(y);
+            if (std::abs(x - std::round(x)) < 1e-6)
+                x = std::round(x);
+
+            NEIGHBOR point;
+            int y0 = static_cast<int>(std::floor(y));
+            int x0 = static_cast<int>(std::floor(x));
+            double ty = y - y0;
+            double tx = x - x0;
+            if (ty == 0 && tx == 0)
+            {
+                point.TapNum = 1;
+                point.OffsetY[0] = y0;
+                point.OffsetX[0] = x0;
+                point.Weight[0] = 1.0f;
+            }
+            else
+            {
+                point.TapNum = 4;
+                const int dy[4] = {0, 0, 1, 1};
+                const int dx[4] = {0, 1, 0, 1};
+                const double w[4] = {(1 - ty) * (1 - tx), (1 - ty) * tx, ty * (1 - tx), ty * tx};
+                for (int t = 0; t < 4; t++)
+                {
+                    point.OffsetY[t] = y0 + dy[t];
+                    point.OffsetX[t] = x0 + dx[t];
+                    point.Weight[t] = static_cast<float>(w[t]);
+                }
+            }
+            for (int t = 0; t < point.TapNum; t++)
+            {
+                sampler.Border = std::max(sampler.Border, std::abs(point.OffsetY[t]));
+                sampler.Border = std::max(sampler.Border, std::abs(point.OffsetX[t]));
+            }
+            sampler.Points.push_back(point);
+        }
+
+        // 旋转不变类别表: 取各循环移位中的最小编码, 再按最小编码升序编号
+        const int bits = sampling.Neighbors;
+        if (bits <= 16)
+        {
+            const uint32_t codeNum = 1u << bits;
+            std::vector<uint32_t> minCode(codeNum);
+            std::vector<int> index(codeNum, -1);
+            for (uint32_t code = 0; code < codeNum; code++)
+            {
+                uint32_t m = code;
+                for (int s = 1; s < bits; s++)
+                    m = std::min(m, rotateLeft(code, s, bits));
+                minCode[code] = m;
+                index[m] = 0;
+            }
+            for (uint32_t code = 0; code < codeNum; code++)
+            {
+                if (index[code] >= 0)
+                    index[code] = sampler.RotationNum++;
+            }
+            sampler.RotationTable.resize(codeNum);
+            for (uint32_t code = 0; code < codeNum; code++)
+                sampler.RotationTable[code] = static_cast<ushort>(index[minCode[code]]);
+        }
+        m_samplers.push_back(std::move(sampler));
+    }
+}
+/// @brief 获取第 Index 组采样参数在编码类型下的类别数
+/// @param Index 采样参数下标
+/// @param Type 编码类型
+/// @return 类别数 (直方图的 bin 数)
+int pcv::CircularLBP::getBinNum(int Index, LBP_TYPE Type) const
+{
+    const SAMPLER &sampler = m_samplers.at(Index);
+    checkType(sampler, Type);
+    const int bits = sampler.Neighbors;
+    switch (Type)
+    {
+    case LBP_TYPE::UNIFORM:
+        return bits * (bits - 1) + 3;
+    case LBP_TYPE::ROTATION_INVARIANT:
+        return sampler.RotationNum;
+    case LBP_TYPE::UNIFORM_ROTATION_INVARIANT:
+        return bits + 2;
+    default:
+        return 1 << bits;
+    }
+}
+/// @brief 获取第 Index 组采样参数没有完整邻域的边界宽度, 该范围内的编码为 0
+int pcv::CircularLBP::getBorder(int Index) const
+{
+    return m_samplers.at(Index).Border;
+}
+/// @brief 旋转不变类别表只对 P <= 16 构建
+void pcv::CircularLBP::checkType(const SAMPLER &Sampler, LBP_TYPE Type) const
+{
+    if (Type == LBP_TYPE::ROTATION_INVARIANT && Sampler.RotationTable.empty())
+    {
+        CV_Error(cv::Error::StsBadArg, "ROTATION_INVARIANT只支持采样点数不超过16。");
+    }
+}
+/// @brief 计算一组 (P, R) 在第 Row 行的类别, 只写入 [Border, cols - Border) 范围
+/// 按采样点逐个处理整行, 内层循环连续访问内存, 便于编译器向量化
+void pcv::CircularLBP::calcCodeRow(const SAMPLER &Sampler, const cv::Mat &GrayInMat, int Row, LBP_TYPE Type, int *Codes) const
+{
+    const int begin = Sampler.Border;
+    const int end = GrayInMat.cols - Sampler.Border;
+    if (begin >= end)
+        return;
+    const uchar *center = GrayInMat.ptr<uchar>(Row);
+    std::fill(Codes + begin, Codes + end, 0);
+    for (int p = 0; p < Sampler.Neighbors; p++)
+    {
+        const NEIGHBOR &point = Sampler.Points[p];
+        if (point.TapNum == 1)
+        {
+            const uchar *s = GrayInMat.ptr<uchar>(Row + point.OffsetY[0]) + point.OffsetX[0];
+            for (int x = begin; x < end; x++)
+                Codes[x] |= static_cast<int>(s[x] >= center[x]) << p;
+        }
+        else
+        {
+            const uchar *s0 = GrayInMat.ptr<uchar>(Row + point.OffsetY[0]) + point.OffsetX[0];
+            const uchar *s1 = GrayInMat.ptr<uchar>(Row + point.OffsetY[1]) + point.OffsetX[1];
+            const uchar *s2 = GrayInMat.ptr<uchar>(Row + point.OffsetY[2]) + point.OffsetX[2];
+            const uchar *s3 = GrayInMat.ptr<uchar>(Row + point.OffsetY[3]) + point.OffsetX[3];
+            const float w0 = point.Weight[0], w1 = point.Weight[1], w2 = point.Weight[2], w3 = point.Weight[3];
+            for (int x = begin; x < end; x++)
+            {
+                // 容许插值的浮点舍入误差, 与中心相等的邻域按 >= 处理
+                float v = w0 * s0[x] + w1 * s1[x] + w2 * s2[x] + w3 * s3[x] + 1e-4f;
+                Codes[x] |= static_cast<int>(v >= center[x]) << p;
+            }
+        }
+    }
+
+    const int bits = Sampler.Neighbors;
+    switch (Type)
+    {
+    case LBP_TYPE::UNIFORM:
+        for (int x = begin; x < end; x++)
+            Codes[x] = uniformClass(static_cast<uint32_t>(Codes[x]), bits);
+        break;
+    case LBP_TYPE::ROTATION_INVARIANT:
+        for (int x = begin; x < end; x++)
+            Codes[x] = Sampler.RotationTable[Codes[x]];
+        break;
+    case LBP_TYPE::UNIFORM_ROTATION_INVARIANT:
+        for (int x = begin; x < end; x++)
+            Codes[x] = uniformRotationClass(static_cast<uint32_t>(Codes[x]), bits);
+        break;
+    default:
+        break;
+    }
+}
+/// @brief 计算多通道编码图像
+/// @param GrayInMat 输入灰度图像
+/// @param OutMat 输出编码图像(CV_32SC(n)), 第 k 通道为第 k 组 (P, R) 的类别, 各组边界宽度内为 0
+/// @param Type 编码类型
+void pcv::CircularLBP::compute(const cv::Mat &GrayInMat, cv::Mat &OutMat, LBP_TYPE Type) const
+{
+    checkGrayInput(GrayInMat);
+    for (const SAMPLER &sampler : m_samplers)
+        checkType(sampler, Type);
+    cv::Mat src = GrayInMat;
+    const int channels = getSamplingNum();
+    OutMat.create(src.size(), CV_32SC(channels));
+    OutMat.setTo(cv::Scalar::all(0));
+
+    cv::parallel_for_(cv::Range(0, src.rows), [&](const cv::Range &range) {
+        std::vector<int> codes(src.cols);
+        for (int r = range.start; r < range.end; r++)
+        {
+            int *dst = OutMat.ptr<int>(r);
+            for (int k = 0; k < channels; k++)
+            {
+                const SAMPLER &sampler = m_samplers[k];
+                if (r < sampler.Border || r >= src.rows - sampler.Border)
+                    continue;
+                calcCodeRow(sampler, src, r, Type, codes.data());
+                for (int c = sampler.Border; c < src.cols - sampler.Border; c++)
+                    dst[c * channels + k] = codes[c];
+            }
+        }
+    });
+}
+/// @brief 计算拼接的分块直方图, 编码逐行计算后直接累加到所在块的直方图
+/// 图像按 CellSize 划分, 右侧和下方不足一块的部分忽略; 每组 (P, R) 只统计其边界宽度以内的像素。
+/// @param GrayInMat 输入灰度图像
+/// @param OutHist 输出直方图(CV_32FC1), 每行对应一个块 (按行优先顺序), 各组 (P, R) 的直方图依次拼接
+/// @param CellSize 块大小
+/// @param Type 编码类型, DEFAULT 只支持采样点数不超过 16
+/// @param Normalize 是否将每个块中每组 (P, R) 的直方图分别归一化为和为 1
+void pcv::CircularLBP::computeHist(const cv::Mat &GrayInMat, cv::Mat &OutHist, const cv::Size &CellSize, LBP_TYPE Type, bool Normalize) const
+{
+    checkGrayInput(GrayInMat);
+    if (CellSize.width <= 0 || CellSize.height <= 0)
+    {
+        CV_Error(cv::Error::StsBadArg, "CellSize必须为正数。");
+    }
+    const int cellsX = GrayInMat.cols / CellSize.width;
+    const int cellsY = GrayInMat.rows / CellSize.height;
+    if (cellsX == 0 || cellsY == 0)
+    {
+        CV_Error(cv::Error::StsBadArg, "输入图像小于CellSize。");
+    }
+
+    const int samplingNum = getSamplingNum();
+    std::vector<int> binOffsets(samplingNum + 1, 0);
+    for (int k = 0; k < samplingNum; k++)
+    {
+        if (Type == LBP_TYPE::DEFAULT && m_samplers[k].Neighbors > 16)
+        {
+            CV_Error(cv::Error::StsBadArg, "DEFAULT直方图只支持采样点数不超过16。");
+        }
+        binOffsets[k + 1] = binOffsets[k] + getBinNum(k, Type);
+    }
+    const int rows = GrayInMat.rows;
+    const int cols = GrayInMat.cols;
+    OutHist.create(cellsX * cellsY, binOffsets[samplingNum], CV_32FC1);
+    OutHist.setTo(cv::Scalar::all(0));
+
+    cv::parallel_for_(cv::Range(0, cellsY), [&](const cv::Range &range) {
+        std::vector<int> codes(cols);
+        for (int cy = range.start; cy < range.end; cy++)
+        {
+            for (int k = 0; k < samplingNum; k++)
+            {
+                const SAMPLER &sampler = m_samplers[k];
+                int rowBegin = std::max(cy * CellSize.height, sampler.Border);
+                int rowEnd = std::min((cy + 1) * CellSize.height, rows - sampler.Border);
+                for (int r = rowBegin; r < rowEnd; r++)
+                {
+                    calcCodeRow(sampler, GrayInMat, r, Type, codes.data());
+                    for (int cx = 0; cx < cellsX; cx++)
+                    {
+                        float *hist = OutHist.ptr<float>(cy * cellsX + cx) + binOffsets[k];
+                        int colBegin = std::max(cx * CellSize.width, sampler.Border);
+                        int colEnd = std::min((cx + 1) * CellSize.width, cols - sampler.Border);
+                        for (int c = colBegin; c < colEnd; c++)
+                            hist[codes[c]] += 1.0f;
+                    }
+                }
+            }
+            if (Normalize)
+            {
+                for (int cx = 0; cx < cellsX; cx++)
+                {
+                    float *hist = OutHist.ptr<float>(cy * cellsX + cx);
+                    for (int k = 0; k < samplingNum; k++)
+                    {
+                        float sum = 0.0f;
+                        for (int b = binOffsets[k]; b < binOffsets[k + 1]; b++)
+                            sum += hist[b];
+                        if (sum > 0)
+                        {
+                            for (int b = binOffsets[k]; b < binOffsets[k + 1]; b++)
+                                hist[b] /= sum;
+                        }
+                    }
+                }
+            }
+        }
+    });
+}
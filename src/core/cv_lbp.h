@@ -0,0 +1,74 @@
+#ifndef H_PCV_LBP
+#define H_PCV_LBP
+
+#include <vector>
+#include <opencv2/core.hpp>
+
+namespace pcv
+{
+    /// @brief LBP 编码类型
+    enum class LBP_TYPE
+    {
+        DEFAULT,                   // 原始 8 邻域编码, 256 类
+        UNIFORM,                   // 等价模式, 58 个等价模式 + 1 个非等价类, 共 59 类
+        ROTATION_INVARIANT,        // 旋转不变模式, 36 类
+        UNIFORM_ROTATION_INVARIANT // 旋转不变等价模式 (riu2), 10 类
+    };
+
+    int getLBPBinNum(LBP_TYPE Type);                                                            // 获取编码类型的类别数
+    void calcLBP(const cv::Mat &GrayInMat, cv::Mat &OutMat, LBP_TYPE Type = LBP_TYPE::DEFAULT); // 计算 LBP 编码图像
+    void calcLBPHist(const cv::Mat &GrayInMat, cv::Mat &OutHist, const cv::Size &CellSize,
+                     LBP_TYPE Type = LBP_TYPE::UNIFORM, bool Normalize = true);                 // 计算分块 LBP 直方图
+
+    /// @brief 圆形 LBP 的采样参数 LBP_{P,R}
+    struct LBP_SAMPLING
+    {
+        int Neighbors; // 采样点数 P, 位于 [4, 24]
+        double Radius; // 采样半径 R
+    };
+
+    /// @brief 多半径多邻域圆形 LBP
+    /// 构造时为每组 (P, R) 预计算采样点的双线性插值偏移和权重, 对象可在多帧之间复用;
+    /// 每行只遍历一次, 同时计算所有 (P, R) 的编码。
+    /// 第 p 个采样点位于角度 2*pi*p/P (自右侧起逆时针), 对应编码的第 p 位。
+    /// 等价模式类别按 (1 的个数, 起始位置) 编号, 与 calcLBP 的 8 邻域类别编号不同。
+    class CircularLBP
+    {
+    public:
+        explicit CircularLBP(const std::vector<LBP_SAMPLING> &Samplings);
+
+        int getSamplingNum() const { return static_cast<int>(m_samplers.size()); } // 采样参数组数
+        int getBinNum(int Index, LBP_TYPE Type) const;                             // 第 Index 组的类别数
+        int getBorder(int Index) const;                                            // 第 Index 组没有完整邻域的边界宽度
+        void compute(const cv::Mat &GrayInMat, cv::Mat &OutMat, LBP_TYPE Type = LBP_TYPE::DEFAULT) const; // 计算多通道编码图像
+        void computeHist(const cv::Mat &GrayInMat, cv::Mat &OutHist, const cv::Size &CellSize,
+                         LBP_TYPE Type = LBP_TYPE::UNIFORM_ROTATION_INVARIANT,
+                         bool Normalize = true) const;                                          // 计算拼接的分块直方图
+
+    private:
+        /// @brief 单个采样点: 整数位置只有 1 个抽头, 否则为双线性插值的 4 个抽头
+        struct NEIGHBOR
+        {
+            int TapNum;
+            int OffsetY[4];
+            int OffsetX[4];
+            float Weight[4];
+        };
+
+        /// @brief 一组 (P, R) 的预计算数据
+        struct SAMPLER
+        {
+            int Neighbors;
+            int Border;
+            std::vector<NEIGHBOR> Points;
+            std::vector<ushort> RotationTable; // 旋转不变类别表, 仅 P <= 16 时构建
+            int RotationNum;                   // 旋转不变类别数, 仅 P <= 16 时有效
+        };
+
+        void calcCodeRow(const SAMPLER &Sampler, const cv::Mat &GrayInMat, int Row, LBP_TYPE Type, int *Codes) const;
+        void checkType(const SAMPLER &Sampler, LBP_TYPE Type) const;
+
+        std::vector<SAMPLER> m_samplers;
+    };
+}; // namespace pcv
+#endif // H_PCV_LBP
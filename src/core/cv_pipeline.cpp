@@ -0,0 +1,335 @@
+#include "cv_pipeline.h"
+#include <algorithm>
+#include <climits>
+
+pcv::Pipeline::Pipeline()
+{
+    NODE input;
+    input.name = "input";
+    m_nodes.push_back(std::move(input));
+}
+/// @brief 添加节点, 输入必须是已添加的非 SINK 节点
+int pcv::Pipeline::addNode(NODE &&Node)
+{
+    for (int in : Node.inputs)
+    {
+        if (in < 0 || in >= static_cast<int>(m_nodes.size()) || m_nodes[in].kind == NODE_KIND::SINK)
+        {
+            CV_Error(cv::Error::StsBadArg, "阶段的输入节点不存在或没有图像输出。");
+        }
+    }
+    m_nodes.push_back(std::move(Node));
+    m_compiled = false;
+    return static_cast<int>(m_nodes.size()) - 1;
+}
+/// @brief 添加多输入阶段
+/// @param Name 阶段名
+/// @param Inputs 输入节点
+/// @param Func 阶段函数, 需把结果写入 OutMat (OutMat 可能持有上一次使用的缓冲, 尺寸类型匹配时应复用)
+/// @return 节点编号
+int pcv::Pipeline::addStage(const std::string &Name, const std::vector<int> &Inputs, const STAGE_FUNC &Func)
+{
+    NODE node;
+    node.name = Name;
+    node.kind = NODE_KIND::STAGE;
+    node.inputs = Inputs;
+    node.func = Func;
+    return addNode(std::move(node));
+}
+/// @brief 添加单输入阶段
+int pcv::Pipeline::addStage(const std::string &Name, int Input, const UNARY_FUNC &Func)
+{
+    return addStage(Name, std::vector<int>{Input}, [Func](const std::vector<cv::Mat> &InMats, cv::Mat &OutMat) {
+        Func(InMats[0], OutMat);
+    });
+}
+/// @brief 添加逐像素查表阶段, 与前一个无分支的查表阶段在编译时复合
+int pcv::Pipeline::addPointOp(const std::string &Name, int Input, const PointOpChain &Chain)
+{
+    NODE node;
+    node.name = Name;
+    node.kind = NODE_KIND::POINT_OP;
+    node.inputs = {Input};
+    node.chain.lut(Chain.getLut()); // 复制查表, 不与调用者的 Chain 共享内存
+    return addNode(std::move(node));
+}
+/// @brief 添加无图像输出的阶段, 结果由 Func 自行保存
+int pcv::Pipeline::addSink(const std::string &Name, int Input, const SINK_FUNC &Func)
+{
+    NODE node;
+    node.name = Name;
+    node.kind = NODE_KIND::SINK;
+    node.inputs = {Input};
+    node.sink = Func;
+    return addNode(std::move(node));
+}
+/// @brief 添加 letterbox 阶段
+/// @param OutPads 非空时保存最近一次 run 的填充尺寸
+int pcv::Pipeline::addLetterbox(int Input, const cv::Size &TargetSize, const cv::Scalar &PadColor, BOX_RECT *OutPads)
+{
+    return addStage("letterbox", Input, [TargetSize, PadColor, OutPads](const cv::Mat &InMat, cv::Mat &OutMat) {
+        BOX_RECT pads;
+        letterbox(InMat, OutMat, pads, TargetSize, PadColor);
+        if (OutPads != nullptr)
+            *OutPads = pads;
+    });
+}
+/// @brief 添加 equalizeColor 阶段
+int pcv::Pipeline::addEqualizeColor(int Input, double ClipLimit)
+{
+    return addStage("equalizeColor", Input, [ClipLimit](const cv::Mat &InMat, cv::Mat &OutMat) {
+        equalizeColor(InMat, OutMat, ClipLimit);
+    });
+}
+/// @brief 添加 threshold 阶段 (查表实现, 可与前面的点运算融合)
+int pcv::Pipeline::addThreshold(int Input, double MinGray, double MaxGray)
+{
+    PointOpChain chain;
+    chain.threshold(MinGray, MaxGray);
+    return addPointOp("threshold", Input, chain);
+}
+/// @brief 标记输出节点, 输出节点不参与融合且独占缓冲
+void pcv::Pipeline::setOutput(int Node)
+{
+    if (Node < 0 || Node >= static_cast<int>(m_nodes.size()) || m_nodes[Node].kind == NODE_KIND::SINK)
+    {
+        CV_Error(cv::Error::StsBadArg, "输出节点不存在或没有图像输出。");
+    }
+    if (std::find(m_outputs.begin(), m_outputs.end(), Node) == m_outputs.end())
+    {
+        m_nodes[Node].isOutput = true;
+        m_outputs.push_back(Node);
+    }
+    m_compiled = false;
+}
+/// @brief 编译: 融合查表阶段, 分层, 分配缓冲
+void pcv::Pipeline::compile()
+{
+    m_plan = m_nodes;
+    const int nodeNum = static_cast<int>(m_plan.size());
+
+    // Step 1: 唯一后继为查表阶段的查表阶段并入后继
+    std::vector<int> consumers(nodeNum, 0);
+    for (const NODE &node : m_plan)
+    {
+        for (int in : node.inputs)
+            consumers[in]++;
+    }
+    for (int i = 1; i < nodeNum; i++)
+    {
+        NODE &node = m_plan[i];
+        if (node.kind != NODE_KIND::POINT_OP)
+            continue;
+        NODE &prev = m_plan[node.inputs[0]];
+        if (prev.kind != NODE_KIND::POINT_OP || prev.isOutput || consumers[node.inputs[0]] != 1)
+            continue;
+        PointOpChain fused;
+        fused.lut(prev.chain.getLut());
+        fused.lut(node.chain.getLut());
+        node.chain = fused;
+        node.name = prev.name + "+" + node.name;
+        node.inputs = prev.inputs;
+        prev.removed = true;
+    }
+
+    // Step 2: 按依赖深度分层, 只依赖输入的阶段在第 0 层
+    m_plan[INPUT].level = -1;
+    int levelNum = 0;
+    for (int i = 1; i < nodeNum; i++)
+    {
+        NODE &node = m_plan[i];
+        if (node.removed)
+            continue;
+        node.level = 0;
+        for (int in : node.inputs)
+            node.level = std::max(node.level, m_plan[in].level + 1);
+        levelNum = std::max(levelNum, node.level + 1);
+    }
+    m_levels.assign(levelNum, std::vector<int>());
+    m_timings.clear();
+    m_timingIndex.assign(nodeNum, -1);
+    for (int i = 1; i < nodeNum; i++)
+    {
+        if (m_plan[i].removed)
+            continue;
+        m_levels[m_plan[i].level].push_back(i);
+        m_timingIndex[i] = static_cast<int>(m_timings.size());
+        m_timings.push_back({m_plan[i].name, 0.0});
+    }
+
+    // Step 3: 中间结果在最后一个读取它的层结束后释放, 同层阶段可能并行, 只复用更早层释放的缓冲
+    std::vector<int> lastUse(nodeNum, -1);
+    for (int i = 1; i < nodeNum; i++)
+    {
+        const NODE &node = m_plan[i];
+        if (node.removed)
+            continue;
+        for (int in : node.inputs)
+            lastUse[in] = std::max(lastUse[in], node.level);
+        if (node.isOutput)
+            lastUse[i] = INT_MAX;
+    }
+    // 输出的尺寸类型已知 (上一次 run 记录) 时只复用尺寸类型相同的缓冲, 避免每次 run 重新分配; 未知时各自独占
+    m_outSizes.resize(nodeNum);
+    m_outTypes.resize(nodeNum, -1);
+    std::vector<int> freeSlots;
+    std::vector<std::vector<int>> releaseAfter(levelNum);
+    std::vector<cv::Size> slotSizes;
+    std::vector<int> slotTypes;
+    for (int level = 0; level < levelNum; level++)
+    {
+        for (int i : m_levels[level])
+        {
+            NODE &node = m_plan[i];
+            if (node.kind == NODE_KIND::SINK)
+                continue;
+            node.slot = -1;
+            if (m_outTypes[i] >= 0)
+            {
+                for (size_t k = 0; k < freeSlots.size(); k++)
+                {
+                    if (slotTypes[freeSlots[k]] == m_outTypes[i] && slotSizes[freeSlots[k]] == m_outSizes[i])
+                    {
+                        node.slot = freeSlots[k];
+                        freeSlots.erase(freeSlots.begin() + k);
+                        break;
+                    }
+                }
+            }
+            if (node.slot < 0)
+            {
+                node.slot = static_cast<int>(slotTypes.size());
+                slotSizes.push_back(m_outSizes[i]);
+                slotTypes.push_back(m_outTypes[i]);
+            }
+            // 没有读取者的非输出节点在本层结束后即可释放
+            int releaseLevel = std::max(lastUse[i], level);
+            if (releaseLevel < levelNum)
+                releaseAfter[releaseLevel].push_back(node.slot);
+        }
+        for (int slot : releaseAfter[level])
+        {
+            if (slotTypes[slot] >= 0)
+                freeSlots.push_back(slot);
+        }
+    }
+
+    // 重新规划时沿用尺寸类型相同的旧缓冲
+    std::vector<cv::Mat> oldSlots;
+    oldSlots.swap(m_slots);
+    m_slots.assign(slotTypes.size(), cv::Mat());
+    for (size_t slot = 0; slot < slotTypes.size(); slot++)
+    {
+        for (cv::Mat &old : oldSlots)
+        {
+            if (!old.empty() && old.type() == slotTypes[slot] && old.size() == slotSizes[slot])
+            {
+                m_slots[slot] = old;
+                old.release();
+                break;
+            }
+        }
+    }
+    m_compiled = true;
+}
+int pcv::Pipeline::getStageNum()
+{
+    if (!m_compiled)
+        compile();
+    return static_cast<int>(m_timings.size());
+}
+int pcv::Pipeline::getBufferNum()
+{
+    if (!m_compiled)
+        compile();
+    return static_cast<int>(m_slots.size());
+}
+/// @brief 第 Index 个缓冲, 用于检查缓冲复用
+const cv::Mat &pcv::Pipeline::getBuffer(int Index)
+{
+    if (!m_compiled)
+        compile();
+    return m_slots.at(Index);
+}
+const cv::Mat &pcv::Pipeline::getMat(int Index, const cv::Mat &InMat) const
+{
+    return Index == INPUT ? InMat : m_slots[m_plan[Index].slot];
+}
+/// @brief 执行单个阶段并记录耗时
+void pcv::Pipeline::runNode(int Index, const cv::Mat &InMat)
+{
+    const NODE &node = m_plan[Index];
+    cv::TickMeter tm;
+    tm.start();
+    switch (node.kind)
+    {
+    case NODE_KIND::POINT_OP:
+        node.chain.apply(getMat(node.inputs[0], InMat), m_slots[node.slot]);
+        break;
+    case NODE_KIND::SINK:
+        node.sink(getMat(node.inputs[0], InMat));
+        break;
+    case NODE_KIND::STAGE:
+    {
+        std::vector<cv::Mat> inMats;
+        inMats.reserve(node.inputs.size());
+        for (int in : node.inputs)
+            inMats.push_back(getMat(in, InMat));
+        cv::Mat &outMat = m_slots[node.slot];
+        node.func(inMats, outMat);
+        // 阶段直接返回了输入的视图时复制一份, 否则缓冲复用后会改写仍在使用的数据
+        for (const cv::Mat &in : inMats)
+        {
+            if (outMat.u != nullptr && outMat.u == in.u)
+            {
+                outMat = outMat.clone();
+                break;
+            }
+        }
+        break;
+    }
+    default:
+        break;
+    }
+    // 记录输出的尺寸类型, 与规划时不同则在下一次 run 前重新分配缓冲
+    if (node.slot >= 0)
+    {
+        const cv::Mat &outMat = m_slots[node.slot];
+        if (outMat.type() != m_outTypes[Index] || outMat.size() != m_outSizes[Index])
+        {
+            m_outTypes[Index] = outMat.type();
+            m_outSizes[Index] = outMat.size();
+            m_shapeChanged = true;
+        }
+    }
+    tm.stop();
+    m_timings[m_timingIndex[Index]].Milliseconds = tm.getTimeMilli();
+}
+/// @brief 执行流水线
+/// @param InMat 输入图像
+/// @param OutMats 输出图像, 按 setOutput 的顺序; 与流水线的缓冲共享内存, 下一次 run 前有效
+void pcv::Pipeline::run(const cv::Mat &InMat, std::vector<cv::Mat> &OutMats)
+{
+    if (!m_compiled)
+        compile();
+    m_shapeChanged = false;
+    for (const std::vector<int> &level : m_levels)
+    {
+        if (level.size() == 1)
+        {
+            runNode(level[0], InMat);
+            continue;
+        }
+        cv::parallel_for_(cv::Range(0, static_cast<int>(level.size())), [&](const cv::Range &range) {
+            for (int k = range.start; k < range.end; k++)
+                runNode(level[k], InMat);
+        }, static_cast<double>(level.size()));
+    }
+    OutMats.resize(m_outputs.size());
+    for (size_t k = 0; k < m_outputs.size(); k++)
+    {
+        OutMats[k] = getMat(m_outputs[k], InMat);
+    }
+    if (m_shapeChanged)
+        m_compiled = false;
+}
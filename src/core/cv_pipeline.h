@@ -0,0 +1,97 @@
+#ifndef H_PCV_PIPELINE
+#define H_PCV_PIPELINE
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <vector>
+#include <opencv2/core.hpp>
+#include "cv_core.h"
+#include "cv_point_ops.h"
+
+namespace pcv
+{
+    /// @brief 声明式算子流水线 (有向无环图)
+    /// 阶段按添加顺序编号, 只能引用已添加的节点, 因此添加顺序即拓扑序; 节点 INPUT 为输入图像。
+    /// 编译时:
+    /// 1. 相邻且无分支的逐像素阶段 (addPointOp / addThreshold) 复合为一张查找表;
+    /// 2. 按依赖深度分层, 同层阶段互不依赖, 运行时并行执行;
+    /// 3. 按层计算中间结果的生命周期, 生命周期不重叠且输出尺寸类型相同的中间结果共用同一缓冲, 缓冲跨 run 保留。
+    ///    尺寸类型在 run 时记录: 首次 run 各阶段独占缓冲, 之后按记录重新规划; 输入尺寸变化时再次重新规划。
+    /// 输出节点独占缓冲, run 返回的输出图像在下一次 run 前有效。
+    class Pipeline
+    {
+    public:
+        using STAGE_FUNC = std::function<void(const std::vector<cv::Mat> &InMats, cv::Mat &OutMat)>;
+        using UNARY_FUNC = std::function<void(const cv::Mat &InMat, cv::Mat &OutMat)>;
+        using SINK_FUNC = std::function<void(const cv::Mat &InMat)>;
+
+        /// @brief 阶段耗时
+        struct STAGE_TIME
+        {
+            std::string Name;    // 阶段名, 融合的阶段以 '+' 连接
+            double Milliseconds; // 最近一次 run 的耗时
+        };
+
+        static constexpr int INPUT = 0;
+
+        Pipeline();
+
+        int addStage(const std::string &Name, const std::vector<int> &Inputs, const STAGE_FUNC &Func); // 多输入阶段
+        int addStage(const std::string &Name, int Input, const UNARY_FUNC &Func);                       // 单输入阶段
+        int addPointOp(const std::string &Name, int Input, const PointOpChain &Chain);                  // 逐像素查表阶段, 可融合
+        int addSink(const std::string &Name, int Input, const SINK_FUNC &Func);                         // 无图像输出的阶段 (连通域, 特征等)
+        int addLetterbox(int Input, const cv::Size &TargetSize,
+                         const cv::Scalar &PadColor = cv::Scalar(128, 128, 128), BOX_RECT *OutPads = nullptr); // 同 letterbox
+        int addEqualizeColor(int Input, double ClipLimit = 2.0);                                        // 同 equalizeColor
+        int addThreshold(int Input, double MinGray, double MaxGray);                                    // 同 threshold, 可融合
+        void setOutput(int Node);                                                                       // 标记输出节点
+
+        void compile();                                                      // 融合阶段并分配缓冲, run 时按需自动调用
+        void run(const cv::Mat &InMat, std::vector<cv::Mat> &OutMats);       // 执行, 输出按 setOutput 的顺序
+
+        const std::vector<STAGE_TIME> &getTimings() const { return m_timings; } // 编译后各阶段的耗时, 按拓扑序
+        int getStageNum();                                                   // 编译后的阶段数 (不含输入)
+        int getBufferNum();                                                  // 编译后的缓冲数 (含输出)
+        const cv::Mat &getBuffer(int Index);                                 // 第 Index 个缓冲
+
+    private:
+        enum class NODE_KIND
+        {
+            INPUT,
+            STAGE,
+            POINT_OP,
+            SINK
+        };
+        struct NODE
+        {
+            std::string name;
+            NODE_KIND kind = NODE_KIND::INPUT;
+            std::vector<int> inputs;
+            STAGE_FUNC func;
+            SINK_FUNC sink;
+            PointOpChain chain;
+            bool isOutput = false;
+            bool removed = false; // 已融合进后继阶段
+            int level = 0;
+            int slot = -1;
+        };
+
+        int addNode(NODE &&Node);
+        void runNode(int Index, const cv::Mat &InMat);
+        const cv::Mat &getMat(int Index, const cv::Mat &InMat) const;
+
+        std::vector<NODE> m_nodes;              // 声明的图
+        std::vector<int> m_outputs;             // 输出节点 (声明的编号)
+        bool m_compiled = false;
+        std::vector<NODE> m_plan;               // 编译后的图, 编号与 m_nodes 相同
+        std::vector<std::vector<int>> m_levels; // 各层阶段
+        std::vector<int> m_timingIndex;         // 编号 -> m_timings 下标
+        std::vector<cv::Mat> m_slots;           // 缓冲
+        std::vector<cv::Size> m_outSizes;       // 各节点最近一次输出的尺寸 (按声明的编号)
+        std::vector<int> m_outTypes;            // 各节点最近一次输出的类型, 未知为 -1
+        std::atomic<bool> m_shapeChanged{false};
+        std::vector<STAGE_TIME> m_timings;
+    };
+}; // namespace pcv
+#endif // H_PCV_PIPELINE
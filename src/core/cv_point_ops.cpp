@@ -0,0 +1,137 @@
+#include "cv_point_ops.h"
+#include <array>
+#include <cassert>
+#include <cmath>
+#include "cv_core.h"
+
+pcv::PointOpChain::PointOpChain()
+{
+    reset();
+}
+/// @brief 清空为恒等映射
+void pcv::PointOpChain::reset()
+{
+    m_lut.create(1, 256, CV_8UC1);
+    uchar *lut = m_lut.ptr<uchar>();
+    for (int i = 0; i < 256; i++)
+        lut[i] = static_cast<uchar>(i);
+}
+/// @brief 在当前映射之后追加一张单通道查找表: lut[c][i] = Table[lut[c][i]]
+pcv::PointOpChain &pcv::PointOpChain::compose(const uchar *Table)
+{
+    uchar *lut = m_lut.ptr<uchar>();
+    const int total = 256 * m_lut.channels();
+    for (int i = 0; i < total; i++)
+        lut[i] = Table[lut[i]];
+    return *this;
+}
+/// @brief 灰度缩放, 低于 MinGray 为 0, 高于 MaxGray 为 255
+pcv::PointOpChain &pcv::PointOpChain::scale(double MinGray, double MaxGray)
+{
+    assert(MinGray >= 0 && MinGray <= 255 && "MinGray must be in the range [0, 255]");
+    assert(MaxGray >= 0 && MaxGray <= 255 && "MaxGray must be in the range [0, 255]");
+    double mult = 255.0 / (MaxGray - MinGray);
+    double add = -mult * MinGray;
+    std::array<uchar, 256> table;
+    for (int i = 0; i < 256; i++)
+        table[i] = cv::saturate_cast<uchar>(i * mult + add);
+    return compose(table.data());
+}
+/// @brief 伽马校正
+pcv::PointOpChain &pcv::PointOpChain::gamma(float Gamma)
+{
+    std::array<uchar, 256> table;
+    for (int i = 0; i < 256; i++)
+        table[i] = cv::saturate_cast<uchar>(std::pow(static_cast<float>(i) / 255.0f, 1.0f / Gamma) * 255.0f);
+    return compose(table.data());
+}
+/// @brief 对数变换
+pcv::PointOpChain &pcv::PointOpChain::log(float C)
+{
+    std::array<uchar, 256> table;
+    for (int i = 0; i < 256; i++)
+        table[i] = cv::saturate_cast<uchar>(C * std::log(1 + i));
+    return compose(table.data());
+}
+/// @brief 反转
+pcv::PointOpChain &pcv::PointOpChain::invert()
+{
+    std::array<uchar, 256> table;
+    for (int i = 0; i < 256; i++)
+        table[i] = static_cast<uchar>(255 - i);
+    return compose(table.data());
+}
+/// @brief 二值化, 灰度位于 (MinGray, MaxGray] 为 255, 其余为 0 (与 cv::threshold 一样阈值先向下取整)
+pcv::PointOpChain &pcv::PointOpChain::threshold(double MinGray, double MaxGray)
+{
+    assert(MinGray >= 0 && MinGray <= 255 && "MinGray must be in the range [0, 255]");
+    assert(MaxGray >= 0 && MaxGray <= 255 && "MaxGray must be in the range [0, 255]");
+    const int minGray = cvFloor(MinGray);
+    const int maxGray = cvFloor(MaxGray);
+    std::array<uchar, 256> table;
+    for (int i = 0; i < 256; i++)
+        table[i] = (i > minGray && i <= maxGray) ? 255 : 0;
+    return compose(table.data());
+}
+/// @brief 分段线性变换
+pcv::PointOpChain &pcv::PointOpChain::linearLevel(int Th1, int Th2, int Goal1, int Goal2)
+{
+    std::array<uchar, 256> table;
+    cv::Mat Lut(1, 256, CV_8UC1, table.data());
+    linearLevelLut(Th1, Th2, Goal1, Goal2, Lut);
+    return compose(table.data());
+}
+/// @brief 追加自定义查找表
+/// 单通道查找表作用于所有通道; 多通道查找表逐通道作用, 此后整条映射链均按通道保存
+pcv::PointOpChain &pcv::PointOpChain::lut(const cv::Mat &Lut)
+{
+    if (Lut.total() != 256 || Lut.depth() != CV_8U || !Lut.isContinuous())
+    {
+        CV_Error(cv::Error::StsBadArg, "Lut必须为连续的256项8位查找表。");
+    }
+    const int channels = Lut.channels();
+    if (channels == 1)
+        return compose(Lut.ptr<uchar>());
+    if (m_lut.channels() != 1 && m_lut.channels() != channels)
+    {
+        CV_Error(cv::Error::StsBadArg, "Lut的通道数与已记录的映射不一致。");
+    }
+
+    // 单通道映射扩展为逐通道映射
+    if (m_lut.channels() == 1)
+    {
+        cv::Mat expanded(1, 256, CV_8UC(channels));
+        const uchar *src = m_lut.ptr<uchar>();
+        uchar *dst = expanded.ptr<uchar>();
+        for (int i = 0; i < 256; i++)
+        {
+            for (int c = 0; c < channels; c++)
+                dst[i * channels + c] = src[i];
+        }
+        m_lut = expanded;
+    }
+    uchar *lut = m_lut.ptr<uchar>();
+    const uchar *table = Lut.ptr<uchar>();
+    for (int i = 0; i < 256; i++)
+    {
+        for (int c = 0; c < channels; c++)
+            lut[i * channels + c] = table[lut[i * channels + c] * channels + c];
+    }
+    return *this;
+}
+/// @brief 对 8 位图像执行整条映射链, 只遍历一次图像
+/// @param InMat 输入图像, 逐通道查找表要求通道数与查找表一致
+/// @param OutMat 输出图像, 尺寸类型与输入一致时直接写入其内存; 可与 InMat 相同
+void pcv::PointOpChain::apply(const cv::Mat &InMat, cv::Mat &OutMat) const
+{
+    assert(!InMat.empty() && "Input image is empty");
+    if (InMat.depth() != CV_8U)
+    {
+        CV_Error(cv::Error::StsBadArg, "输入的InMat不是8位图像。");
+    }
+    if (m_lut.channels() != 1 && m_lut.channels() != InMat.channels())
+    {
+        CV_Error(cv::Error::StsBadArg, "输入图像的通道数与查找表不一致。");
+    }
+    cv::LUT(InMat, m_lut, OutMat);
+}
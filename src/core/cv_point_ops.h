@@ -0,0 +1,35 @@
+#ifndef H_PCV_POINT_OPS
+#define H_PCV_POINT_OPS
+
+#include <opencv2/core.hpp>
+
+namespace pcv
+{
+    /// @brief 逐像素灰度映射链
+    /// 依次记录 scaleImage / gammaImage / logImage / invertImage / threshold 等 8 位点运算,
+    /// 记录时即复合为一张 256 项查找表, apply 只遍历一次图像。
+    /// 各步骤的结果与依次调用对应的 pcv 函数相同。
+    class PointOpChain
+    {
+    public:
+        PointOpChain();
+
+        PointOpChain &scale(double MinGray, double MaxGray);                 // 同 scaleImage
+        PointOpChain &gamma(float Gamma);                                    // 同 gammaImage
+        PointOpChain &log(float C);                                          // 同 logImage
+        PointOpChain &invert();                                              // 同 invertImage
+        PointOpChain &threshold(double MinGray, double MaxGray);             // 同 threshold
+        PointOpChain &linearLevel(int Th1, int Th2, int Goal1, int Goal2);   // 同 linearLevelTrans
+        PointOpChain &lut(const cv::Mat &Lut);                               // 自定义查找表 (1x256, CV_8UC1 或每通道一张的 CV_8UC(n))
+        void reset();                                                        // 清空为恒等映射
+
+        const cv::Mat &getLut() const { return m_lut; }                      // 复合后的查找表
+        void apply(const cv::Mat &InMat, cv::Mat &OutMat) const;             // 单次查表, OutMat 尺寸类型匹配时复用其内存
+
+    private:
+        PointOpChain &compose(const uchar *Table);
+
+        cv::Mat m_lut; // 1x256, CV_8UC1 或 CV_8UC(n)
+    };
+}; // namespace pcv
+#endif // H_PCV_POINT_OPS
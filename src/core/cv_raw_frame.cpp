@@ -0,0 +1,348 @@
+#include "cv_raw_frame.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    const char RAW_MAGIC[8] = {'P', 'C', 'V', 'R', 'A', 'W', '0', '1'};
+    const uint32_t RAW_VERSION = 1;
+    const size_t RAW_ROW_ALIGN = 64;    // 行跨度对齐, 便于 SIMD 访问
+    const size_t RAW_DATA_ALIGN = 4096; // 数据偏移按页对齐
+
+    /// @brief 文件头, 固定 64 字节
+    struct RAW_HEADER
+    {
+        char magic[8];
+        uint32_t version;
+        int32_t rows;
+        int32_t cols;
+        int32_t type;
+        uint64_t stride;
+        uint32_t tileNum;
+        uint32_t reserved;
+        uint64_t dataOffset;
+        uint8_t padding[16];
+    };
+    static_assert(sizeof(RAW_HEADER) == 64, "RAW_HEADER must be 64 bytes");
+
+    /// @brief 分块索引项
+    struct RAW_TILE
+    {
+        int32_t x;
+        int32_t y;
+        int32_t width;
+        int32_t height;
+    };
+    static_assert(sizeof(RAW_TILE) == 16, "RAW_TILE must be 16 bytes");
+
+    inline size_t alignUp(size_t Value, size_t Align)
+    {
+        return (Value + Align - 1) / Align * Align;
+    }
+#ifndef _WIN32
+    size_t getPageSize()
+    {
+        return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    }
+#endif
+} // namespace
+
+pcv::RawFrameFile::~RawFrameFile()
+{
+    close();
+}
+/// @brief 映射文件
+/// @param FileSize 新建时的文件大小, 打开已有文件时忽略
+void pcv::RawFrameFile::map(const std::string &Path, size_t FileSize, bool Writable, bool Create)
+{
+    close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(Path.c_str(), GENERIC_READ | (Writable ? GENERIC_WRITE : 0), FILE_SHARE_READ, nullptr,
+                              Create ? CREATE_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        CV_Error(cv::Error::StsError, "无法打开文件: " + Path);
+    }
+    m_file = file;
+    if (!Create)
+    {
+        LARGE_INTEGER size;
+        GetFileSizeEx(file, &size);
+        FileSize = static_cast<size_t>(size.QuadPart);
+    }
+    if (FileSize == 0)
+    {
+        close();
+        CV_Error(cv::Error::StsError, "文件为空: " + Path);
+    }
+    // 新建时 CreateFileMapping 按映射大小扩展文件
+    HANDLE mapping = CreateFileMappingA(file, nullptr, Writable ? PAGE_READWRITE : PAGE_READONLY,
+                                        static_cast<DWORD>(static_cast<uint64_t>(FileSize) >> 32),
+                                        static_cast<DWORD>(FileSize & 0xFFFFFFFFu), nullptr);
+    if (mapping == nullptr)
+    {
+        close();
+        CV_Error(cv::Error::StsError, "无法映射文件: " + Path);
+    }
+    m_mapping = mapping;
+    void *base = MapViewOfFile(mapping, Writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0);
+    if (base == nullptr)
+    {
+        close();
+        CV_Error(cv::Error::StsError, "无法映射文件: " + Path);
+    }
+#else
+    int fd = ::open(Path.c_str(), (Writable ? O_RDWR : O_RDONLY) | (Create ? O_CREAT | O_TRUNC : 0), 0644);
+    if (fd < 0)
+    {
+        CV_Error(cv::Error::StsError, "无法打开文件: " + Path);
+    }
+    m_fd = fd;
+    if (Create)
+    {
+        if (ftruncate(fd, static_cast<off_t>(FileSize)) != 0)
+        {
+            close();
+            CV_Error(cv::Error::StsError, "无法设置文件大小: " + Path);
+        }
+    }
+    else
+    {
+        struct stat st;
+        if (fstat(fd, &st) != 0)
+        {
+            close();
+            CV_Error(cv::Error::StsError, "无法读取文件信息: " + Path);
+        }
+        FileSize = static_cast<size_t>(st.st_size);
+    }
+    if (FileSize == 0)
+    {
+        close();
+        CV_Error(cv::Error::StsError, "文件为空: " + Path);
+    }
+    void *base = mmap(nullptr, FileSize, PROT_READ | (Writable ? PROT_WRITE : 0), MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED)
+    {
+        close();
+        CV_Error(cv::Error::StsError, "无法映射文件: " + Path);
+    }
+#endif
+    m_base = static_cast<uchar *>(base);
+    m_mappedSize = FileSize;
+    m_writable = Writable;
+}
+/// @brief 打开已有的原始帧文件并校验文件头
+/// @param Path 文件路径
+/// @param Writable 是否以可写方式映射; 只读映射返回的 Mat 不能写入
+void pcv::RawFrameFile::open(const std::string &Path, bool Writable)
+{
+    map(Path, 0, Writable, false);
+
+    RAW_HEADER header;
+    if (m_mappedSize < sizeof(RAW_HEADER))
+    {
+        close();
+        CV_Error(cv::Error::StsParseError, "文件过小, 不是原始帧文件: " + Path);
+    }
+    std::memcpy(&header, m_base, sizeof(RAW_HEADER));
+    const int depth = CV_MAT_DEPTH(header.type);
+    bool valid = std::memcmp(header.magic, RAW_MAGIC, sizeof(RAW_MAGIC)) == 0 && header.version == RAW_VERSION &&
+                 header.rows > 0 && header.cols > 0 && header.type == CV_MAT_TYPE(header.type) && depth <= CV_64F;
+    if (valid)
+    {
+        const uint64_t rowBytes = static_cast<uint64_t>(header.cols) * CV_ELEM_SIZE(header.type);
+        const uint64_t indexEnd = sizeof(RAW_HEADER) + static_cast<uint64_t>(header.tileNum) * sizeof(RAW_TILE);
+        // 行跨度和数据偏移须按元素大小对齐, 否则 cv::Mat 视图的行首地址不对齐
+        const uint64_t elemSize = CV_ELEM_SIZE1(header.type);
+        valid = header.stride >= rowBytes && header.stride % elemSize == 0 && header.dataOffset % elemSize == 0 &&
+                indexEnd <= header.dataOffset && header.dataOffset <= m_mappedSize &&
+                header.stride <= (m_mappedSize - header.dataOffset) / static_cast<uint64_t>(header.rows);
+    }
+    if (!valid)
+    {
+        close();
+        CV_Error(cv::Error::StsParseError, "原始帧文件头无效: " + Path);
+    }
+
+    m_size = cv::Size(header.cols, header.rows);
+    m_type = header.type;
+    m_stride = static_cast<size_t>(header.stride);
+    m_data = m_base + header.dataOffset;
+    const cv::Rect imageRect(0, 0, m_size.width, m_size.height);
+    m_tiles.resize(header.tileNum);
+    for (uint32_t i = 0; i < header.tileNum; i++)
+    {
+        RAW_TILE tile;
+        std::memcpy(&tile, m_base + sizeof(RAW_HEADER) + i * sizeof(RAW_TILE), sizeof(RAW_TILE));
+        m_tiles[i] = cv::Rect(tile.x, tile.y, tile.width, tile.height);
+        if (m_tiles[i].empty() || (m_tiles[i] & imageRect) != m_tiles[i])
+        {
+            close();
+            CV_Error(cv::Error::StsParseError, "原始帧文件的分块索引超出图像范围: " + Path);
+        }
+    }
+}
+/// @brief 新建原始帧文件, 按 TileSize 划分分块索引
+/// @param Path 文件路径
+/// @param Size 图像尺寸
+/// @param Type 图像类型, 如 CV_8UC1, CV_16UC1
+/// @param TileSize 分块尺寸, 宽或高非正数时取整幅图像的宽或高 (线扫图像常用整行分块)
+void pcv::RawFrameFile::create(const std::string &Path, const cv::Size &Size, int Type, const cv::Size &TileSize)
+{
+    if (Size.width <= 0 || Size.height <= 0)
+    {
+        CV_Error(cv::Error::StsBadArg, "图像尺寸必须为正数。");
+    }
+    const int tileWidth = TileSize.width > 0 ? std::min(TileSize.width, Size.width) : Size.width;
+    const int tileHeight = TileSize.height > 0 ? std::min(TileSize.height, Size.height) : Size.height;
+    std::vector<cv::Rect> tiles;
+    for (int y = 0; y < Size.height; y += tileHeight)
+    {
+        for (int x = 0; x < Size.width; x += tileWidth)
+        {
+            tiles.emplace_back(x, y, std::min(tileWidth, Size.width - x), std::min(tileHeight, Size.height - y));
+        }
+    }
+
+    RAW_HEADER header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, RAW_MAGIC, sizeof(RAW_MAGIC));
+    header.version = RAW_VERSION;
+    header.rows = Size.height;
+    header.cols = Size.width;
+    header.type = CV_MAT_TYPE(Type);
+    header.stride = alignUp(static_cast<size_t>(Size.width) * CV_ELEM_SIZE(Type), RAW_ROW_ALIGN);
+    header.tileNum = static_cast<uint32_t>(tiles.size());
+    header.dataOffset = alignUp(sizeof(RAW_HEADER) + tiles.size() * sizeof(RAW_TILE), RAW_DATA_ALIGN);
+    const size_t fileSize = static_cast<size_t>(header.dataOffset + header.stride * static_cast<uint64_t>(Size.height));
+
+    map(Path, fileSize, true, true);
+    std::memcpy(m_base, &header, sizeof(header));
+    for (size_t i = 0; i < tiles.size(); i++)
+    {
+        RAW_TILE tile = {tiles[i].x, tiles[i].y, tiles[i].width, tiles[i].height};
+        std::memcpy(m_base + sizeof(RAW_HEADER) + i * sizeof(RAW_TILE), &tile, sizeof(RAW_TILE));
+    }
+    m_size = Size;
+    m_type = header.type;
+    m_stride = static_cast<size_t>(header.stride);
+    m_data = m_base + header.dataOffset;
+    m_tiles = std::move(tiles);
+}
+/// @brief 解除映射并关闭文件, 之前返回的 Mat 随之失效
+void pcv::RawFrameFile::close()
+{
+#ifdef _WIN32
+    if (m_base != nullptr)
+        UnmapViewOfFile(m_base);
+    if (m_mapping != nullptr)
+        CloseHandle(static_cast<HANDLE>(m_mapping));
+    if (m_file != nullptr)
+        CloseHandle(static_cast<HANDLE>(m_file));
+    m_mapping = nullptr;
+    m_file = nullptr;
+#else
+    if (m_base != nullptr)
+        munmap(m_base, m_mappedSize);
+    if (m_fd >= 0)
+        ::close(m_fd);
+    m_fd = -1;
+#endif
+    m_base = nullptr;
+    m_data = nullptr;
+    m_mappedSize = 0;
+    m_writable = false;
+    m_size = cv::Size();
+    m_type = 0;
+    m_stride = 0;
+    m_tiles.clear();
+}
+/// @brief 把可写映射的修改同步写回文件
+void pcv::RawFrameFile::flush()
+{
+    if (m_base == nullptr || !m_writable)
+        return;
+#ifdef _WIN32
+    FlushViewOfFile(m_base, 0);
+    FlushFileBuffers(static_cast<HANDLE>(m_file));
+#else
+    msync(m_base, m_mappedSize, MS_SYNC);
+#endif
+}
+/// @brief 整幅图像的视图, 不复制数据
+cv::Mat pcv::RawFrameFile::getMat() const
+{
+    if (m_data == nullptr)
+    {
+        CV_Error(cv::Error::StsError, "文件未打开。");
+    }
+    return cv::Mat(m_size, m_type, m_data, m_stride);
+}
+/// @brief 分块视图, 不复制数据
+/// @param Index 分块序号
+/// @param Halo 向外扩展的像素数 (算子的邻域半径), 裁剪到图像范围
+cv::Mat pcv::RawFrameFile::getTile(int Index, int Halo) const
+{
+    cv::Rect tile = m_tiles.at(Index);
+    cv::Rect expanded(tile.x - Halo, tile.y - Halo, tile.width + 2 * Halo, tile.height + 2 * Halo);
+    return getMat()(expanded & cv::Rect(0, 0, m_size.width, m_size.height));
+}
+/// @brief 对分块覆盖的行给出访问提示, 以页为单位
+void pcv::RawFrameFile::adviseRows(int RowBegin, int RowEnd, bool WillNeed) const
+{
+#ifndef _WIN32
+    if (m_data == nullptr || RowBegin >= RowEnd)
+        return;
+    const size_t pageSize = getPageSize();
+    size_t begin = static_cast<size_t>(m_data - m_base) + static_cast<size_t>(RowBegin) * m_stride;
+    size_t end = static_cast<size_t>(m_data - m_base) + static_cast<size_t>(RowEnd) * m_stride;
+    // 预读时向外取整, 回收时向内取整, 不影响相邻分块
+    begin = WillNeed ? begin / pageSize * pageSize : alignUp(begin, pageSize);
+    end = WillNeed ? std::min(alignUp(end, pageSize), m_mappedSize) : end / pageSize * pageSize;
+    if (begin < end)
+        madvise(m_base + begin, end - begin, WillNeed ? MADV_WILLNEED : MADV_DONTNEED);
+#else
+    (void)RowBegin;
+    (void)RowEnd;
+    (void)WillNeed;
+#endif
+}
+/// @brief 提示系统预读分块所在的页, 可在处理上一块时调用
+void pcv::RawFrameFile::prefetchTile(int Index) const
+{
+    const cv::Rect &tile = m_tiles.at(Index);
+    adviseRows(tile.y, tile.y + tile.height, true);
+}
+/// @brief 提示系统回收分块所在的页; 映射为共享映射, 之后再访问会从文件重新读入
+void pcv::RawFrameFile::evictTile(int Index) const
+{
+    const cv::Rect &tile = m_tiles.at(Index);
+    adviseRows(tile.y, tile.y + tile.height, false);
+}
+/// @brief 把图像写成原始帧文件
+/// @param Path 文件路径
+/// @param InMat 输入图像
+/// @param TileSize 分块尺寸, 同 create
+void pcv::RawFrameFile::write(const std::string &Path, const cv::Mat &InMat, const cv::Size &TileSize)
+{
+    assert(!InMat.empty() && "Input image is empty");
+    RawFrameFile file;
+    file.create(Path, InMat.size(), InMat.type(), TileSize);
+    cv::Mat view = file.getMat();
+    InMat.copyTo(view);
+    file.flush();
+}
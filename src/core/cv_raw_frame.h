@@ -0,0 +1,67 @@
+#ifndef H_PCV_RAW_FRAME
+#define H_PCV_RAW_FRAME
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <opencv2/core.hpp>
+
+namespace pcv
+{
+    /// @brief 内存映射的原始帧文件
+    /// 文件布局 (小端):
+    /// - 64 字节文件头: 标识 "PCVRAW01", 行列数, 类型, 行跨度, 分块数, 数据偏移;
+    /// - 分块索引: 每块 4 个 int32 (x, y, width, height);
+    /// - 按页对齐的像素数据, 逐行存储, 行跨度按 64 字节对齐。
+    /// 打开时整个文件以 mmap 映射, getMat / getTile 返回指向映射页的 cv::Mat, 不复制数据,
+    /// 只有访问到的页才会读入内存, 因此可以逐块处理大于内存的图像。
+    /// 返回的 Mat 不持有映射, 在 close 或析构后失效; 只读映射的 Mat 不能写入 (GLCM::calcGlcmMat 会就地量化输入, 需先复制或以可写方式打开)。
+    class RawFrameFile
+    {
+    public:
+        RawFrameFile() = default;
+        ~RawFrameFile();
+        RawFrameFile(const RawFrameFile &) = delete;
+        RawFrameFile &operator=(const RawFrameFile &) = delete;
+
+        void open(const std::string &Path, bool Writable = false);                                  // 打开已有文件
+        void create(const std::string &Path, const cv::Size &Size, int Type, const cv::Size &TileSize); // 新建文件并以可写方式映射, 内容为 0
+        void close();
+        void flush();                                                                               // 把可写映射的修改写回文件
+
+        bool isOpen() const { return m_data != nullptr; }
+        cv::Size getSize() const { return m_size; }
+        int getType() const { return m_type; }
+        size_t getStride() const { return m_stride; }
+        int getTileNum() const { return static_cast<int>(m_tiles.size()); }
+        cv::Rect getTileRect(int Index) const { return m_tiles.at(Index); }
+
+        cv::Mat getMat() const;                                  // 整幅图像的视图
+        cv::Mat getTile(int Index, int Halo = 0) const;          // 第 Index 块的视图, 按 Halo 向外扩展并裁剪到图像范围
+        void prefetchTile(int Index) const;                      // 提示系统预读该块所在的页
+        void evictTile(int Index) const;                         // 提示系统该块已处理完, 可回收其页
+
+        static void write(const std::string &Path, const cv::Mat &InMat, const cv::Size &TileSize); // 把图像写成原始帧文件
+
+    private:
+        void map(const std::string &Path, size_t FileSize, bool Writable, bool Create);
+        void adviseRows(int RowBegin, int RowEnd, bool WillNeed) const;
+
+        uchar *m_base = nullptr;    // 映射起始地址
+        size_t m_mappedSize = 0;
+        uchar *m_data = nullptr;    // 像素数据起始地址
+        bool m_writable = false;
+        cv::Size m_size;
+        int m_type = 0;
+        size_t m_stride = 0;
+        std::vector<cv::Rect> m_tiles;
+#ifdef _WIN32
+        void *m_file = nullptr;
+        void *m_mapping = nullptr;
+#else
+        int m_fd = -1;
+#endif
+    };
+}; // namespace pcv
+#endif // H_PCV_RAW_FRAME
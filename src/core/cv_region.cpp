@@ -1,9 +1,133 @@
 #include "cv_region.h"
-#include <memory>
+#include <algorithm>
+#include <cmath>
 #include <opencv2/core.hpp>
+#include <opencv2/core/hal/intrin.hpp>
 #include <opencv2/imgproc.hpp>
-#include <Eigen/Dense>
-#include <opencv2/core/eigen.hpp>
+
+namespace
+{
+    /// @brief 将掩膜中的非零像素按行提取为游程
+    /// @param InMat 输入掩膜(CV_8UC1)
+    /// @param OutRuns 输出游程
+    void extractRuns(const cv::Mat &InMat, std::vector<pcv::RUN> &OutRuns)
+    {
+        OutRuns.clear();
+        for (int r = 0; r < InMat.rows; r++)
+        {
+            const uchar *row = InMat.ptr<uchar>(r);
+            int c = 0;
+            while (c < InMat.cols)
+            {
+                if (row[c] == 0)
+                {
+                    c++;
+                    continue;
+                }
+                int start = c;
+                while (c + 1 < InMat.cols && row[c + 1] != 0)
+                    c++;
+                OutRuns.push_back({r, start, c});
+                c++;
+            }
+        }
+    }
+    /// @brief 0..k 的幂和, k 可以为 -1 (空和)
+    inline double powerSum1(double k) { return k * (k + 1) / 2; }
+    inline double powerSum2(double k) { return k * (k + 1) * (2 * k + 1) / 6; }
+    inline double powerSum3(double k) { return powerSum1(k) * powerSum1(k); }
+    /// @brief 在 [0, Num) 中筛选满足条件的下标
+    template <typename Pred>
+    void selectAll(int Num, std::vector<int> &OutIndices, Pred Predicate)
+    {
+        OutIndices.clear();
+        for (int i = 0; i < Num; i++)
+        {
+            if (Predicate(i))
+                OutIndices.push_back(i);
+        }
+    }
+    /// @brief 在给定下标中筛选满足条件的下标, 输入输出为同一对象时原地压缩
+    template <typename Pred>
+    void selectFrom(const std::vector<int> &InIndices, std::vector<int> &OutIndices, Pred Predicate)
+    {
+        if (&InIndices == &OutIndices)
+        {
+            size_t k = 0;
+            for (size_t i = 0; i < OutIndices.size(); i++)
+            {
+                if (Predicate(OutIndices[i]))
+                    OutIndices[k++] = OutIndices[i];
+            }
+            OutIndices.resize(k);
+            return;
+        }
+        OutIndices.clear();
+        for (int index : InIndices)
+        {
+            if (Predicate(index))
+                OutIndices.push_back(index);
+        }
+    }
+    /// @brief 外接矩形宽高是否在给定范围内
+    inline bool inSizeRange(const cv::Rect &Rect, const cv::Size &MinSize, const cv::Size &MaxSize)
+    {
+        return Rect.width >= MinSize.width && Rect.width <= MaxSize.width &&
+               Rect.height >= MinSize.height && Rect.height <= MaxSize.height;
+    }
+    /// @brief 提取一行中灰度位于 (MinGray, MaxGray] 的游程, 不生成掩膜
+    /// 以 SIMD 整块比较, 整块均为背景时直接跳过, 稀疏场景下只做比较
+    void extractThresholdRuns(const uchar *Row, int RowIndex, int Cols, uchar MinGray, uchar MaxGray, std::vector<pcv::RUN> &OutRuns)
+    {
+        int start = -1; // 当前游程起点, -1 表示不在游程内
+        int c = 0;
+#if CV_SIMD
+        const int step = cv::v_uint8::nlanes;
+        const cv::v_uint8 vMin = cv::vx_setall_u8(MinGray), vMax = cv::vx_setall_u8(MaxGray);
+        uchar mask[cv::v_uint8::nlanes];
+        for (; c <= Cols - step; c += step)
+        {
+            cv::v_uint8 v = cv::vx_load(Row + c);
+            cv::v_uint8 in = (v > vMin) & (v <= vMax);
+            if (start < 0 && !cv::v_check_any(in))
+                continue;
+            if (start >= 0 && cv::v_check_all(in))
+                continue;
+            cv::v_store(mask, in);
+            for (int k = 0; k < step; k++)
+            {
+                if (mask[k] && start < 0)
+                {
+                    start = c + k;
+                }
+                else if (!mask[k] && start >= 0)
+                {
+                    OutRuns.push_back({RowIndex, start, c + k - 1});
+                    start = -1;
+                }
+            }
+        }
+#endif
+        for (; c < Cols; c++)
+        {
+            bool in = Row[c] > MinGray && Row[c] <= MaxGray;
+            if (in && start < 0)
+            {
+                start = c;
+            }
+            else if (!in && start >= 0)
+            {
+                OutRuns.push_back({RowIndex, start, c - 1});
+                start = -1;
+            }
+        }
+        if (start >= 0)
+        {
+            OutRuns.push_back({RowIndex, start, Cols - 1});
+        }
+    }
+} // namespace
+
 /// @brief Region类构造函数
 /// @param InMat 输入区域(CV_8UC1)
 /// @param Centroid 输入区域质心
@@ -16,76 +140,106 @@ pcv::Region::Region(const cv::Mat &InMat, const cv::Point2f &Centroid)
     }
     this->m_width = InMat.cols;
     this->m_height = InMat.rows;
-    // this->m_region = InMat.clone();// ROI区域大小
-    std::vector<cv::Vec4i> hierarchy; // 轮廓层级
-    // cv::findContours(this->m_region, this->contours, hierarchy, cv::RETR_TREE, cv::CHAIN_APPROX_SIMPLE, cv::Point()); // 计算区域轮廓
-    cv::findContours(InMat, this->m_contours, hierarchy, cv::RETR_TREE, cv::CHAIN_APPROX_NONE, cv::Point()); // 计算区域轮廓
+    extractRuns(InMat, this->m_runs); // 计算区域游程
 
-    if ((Centroid.x == 0.0f) && (Centroid.y == 0.0f))
-    {
-        std::vector<cv::Point2f> Centroids;
-        pcv::calcCentroid(this->m_contours, Centroids); // 计算质心
-        this->m_centroid = Centroids[0];
-    }
-    else
+    if ((Centroid.x != 0.0f) || (Centroid.y != 0.0f))
     {
         this->m_centroid = Centroid; // 初始化：质心（从外接输入）
+        this->m_hasCentroid = true;
     }
-    this->m_boundingRect = cv::Rect();           // 初始化：外接矩形
-    this->m_minBoundingRect = cv::RotatedRect(); // 初始化：最小外接矩形
-
-    this->m_regionArea = 0.0;          // 初始化：区域面积
-    this->m_minBoundingRectArea = 0.0; // 初始化：最小外接矩形面积
+}
+/// @brief Region类构造函数
+/// @param Runs 区域游程, 按 (row, colStart) 升序且互不重叠
+/// @param Size 原始图像尺寸
+pcv::Region::Region(std::vector<RUN> Runs, const cv::Size &Size)
+    : m_width(Size.width), m_height(Size.height), m_runs(std::move(Runs))
+{
 }
 /// @brief 获取区域大小
 /// @return 区域大小
 cv::Size pcv::Region::getMatSize() const { return cv::Size(this->m_width, this->m_height); }
 /// @brief 获取区域图像
 /// @return 区域图像
-void pcv::Region::getRegion(cv::Mat& RegionMat)
+void pcv::Region::getRegion(cv::Mat& RegionMat) const
 {
     RegionMat = cv::Mat::zeros(this->m_height, this->m_width, CV_8UC1);
-    cv::drawContours(RegionMat, this->m_contours, -1, cv::Scalar::all(255), -1);
+    for (const RUN &run : this->m_runs)
+    {
+        uchar *row = RegionMat.ptr<uchar>(run.row);
+        std::fill(row + run.colStart, row + run.colEnd + 1, static_cast<uchar>(255));
+    }
 }
 /// @brief 获取区域面积
 /// @return 区域面积
-double pcv::Region::getRegionArea()
+double pcv::Region::getRegionArea() const
 {
     if (this->m_regionArea == 0)
     {
-        this->m_regionArea = cv::contourArea(this->m_contours[0]);
+        double area = 0.0;
+        for (const RUN &run : this->m_runs)
+        {
+            area += run.colEnd - run.colStart + 1;
+        }
+        this->m_regionArea = area;
     }
     return this->m_regionArea;
 }
 /// @brief 获取区域质心
 /// @return 区域质心
-cv::Point2f pcv::Region::getCentroid()
+cv::Point2f pcv::Region::getCentroid() const
 {
+    if (!this->m_hasCentroid)
+    {
+        cv::Moments mu = this->getMoments();
+        if (mu.m00 > 0)
+        {
+            this->m_centroid = cv::Point2f(static_cast<float>(mu.m10 / mu.m00), static_cast<float>(mu.m01 / mu.m00));
+        }
+        this->m_hasCentroid = true;
+    }
     return this->m_centroid;
 }
 /// @brief 获取区域的外接矩形
 /// @return 区域外接矩形
-cv::Rect pcv::Region::getBoundingRect()
+cv::Rect pcv::Region::getBoundingRect() const
 {
-    if (this->m_boundingRect.empty())
+    if (this->m_boundingRect.empty() && !this->m_runs.empty())
     {
-        this->m_boundingRect = cv::boundingRect(this->m_contours[0]);
+        // 游程按行升序, 首尾即为上下边界
+        int left = this->m_runs.front().colStart;
+        int right = this->m_runs.front().colEnd;
+        for (const RUN &run : this->m_runs)
+        {
+            left = std::min(left, run.colStart);
+            right = std::max(right, run.colEnd);
+        }
+        int top = this->m_runs.front().row;
+        int bottom = this->m_runs.back().row;
+        this->m_boundingRect = cv::Rect(left, top, right - left + 1, bottom - top + 1);
     }
     return this->m_boundingRect;
 }
 /// @brief 获取区域的最小外接矩形
 /// @return 区域最小外接矩形
-cv::RotatedRect pcv::Region::getMinBoundingRect()
+cv::RotatedRect pcv::Region::getMinBoundingRect() const
 {
-    if (this->m_minBoundingRect.size.width == 0 && this->m_minBoundingRect.size.height == 0)
+    if (this->m_minBoundingRect.size.width == 0 && this->m_minBoundingRect.size.height == 0 && !this->m_runs.empty())
     {
-        this->m_minBoundingRect = cv::minAreaRect(this->m_contours[0]); // 连通域的最小外接矩形
+        // 凸包顶点必为某一游程的端点, 无需追踪轮廓
+        std::vector<cv::Point> points;
+        points.reserve(this->m_runs.size() * 2);
+        for (const RUN &run : this->m_runs)
+        {
+            points.emplace_back(run.colStart, run.row);
+            points.emplace_back(run.colEnd, run.row);
+        }
+        this->m_minBoundingRect = cv::minAreaRect(points); // 连通域的最小外接矩形
     }
     return this->m_minBoundingRect;
 }
 /// @brief 获取区域的最小外接矩形面积
 /// @return 区域最小外接矩形的面积
-double pcv::Region::getMinBoundingRectArea()
+double pcv::Region::getMinBoundingRectArea() const
 {
     if (this->m_minBoundingRectArea == 0)
     {
@@ -95,17 +249,112 @@ double pcv::Region::getMinBoundingRectArea()
     }
     return this->m_minBoundingRectArea;
 }
+/// @brief 获取区域圆度 (面积与以质心到最远像素距离为半径的圆面积之比)
+/// @return 区域圆度 (0, 1]
+double pcv::Region::getCircularity() const
+{
+    if (this->m_circularity == 0 && !this->m_runs.empty())
+    {
+        // 最远的像素必为某一游程的端点
+        cv::Point2f center = this->getCentroid();
+        double maxDist2 = 0.0;
+        for (const RUN &run : this->m_runs)
+        {
+            double dy = run.row - center.y;
+            double dx = std::max(std::abs(run.colStart - center.x), std::abs(run.colEnd - center.x));
+            maxDist2 = std::max(maxDist2, dx * dx + dy * dy);
+        }
+        this->m_circularity = maxDist2 > 0 ? std::min(1.0, this->getRegionArea() / (CV_PI * maxDist2)) : 1.0;
+    }
+    return this->m_circularity;
+}
+/// @brief 获取区域矩
+/// @return 区域矩 (以像素为单位, 与 cv::moments(Mask, true) 一致)
+cv::Moments pcv::Region::getMoments() const
+{
+    if (this->m_moments.m00 == 0)
+    {
+        pcv::calcRunMoments(this->m_runs, this->m_moments);
+    }
+    return this->m_moments;
+}
 /// @brief 获取区域轮廓
 /// @param OutContours 
-void pcv::Region::getContours(std::vector<std::vector<cv::Point>>& OutContours)
+void pcv::Region::getContours(std::vector<std::vector<cv::Point>>& OutContours) const
 {
+    if (!this->m_hasContours)
+    {
+        this->calcContours();
+    }
     OutContours.clear();
     OutContours = this->m_contours;
 }
+/// @brief 由游程计算区域轮廓 (只在外接矩形大小的掩膜上追踪)
+void pcv::Region::calcContours() const
+{
+    this->m_contours.clear();
+    this->m_hasContours = true;
+    cv::Rect bbox = this->getBoundingRect();
+    if (bbox.empty())
+    {
+        return;
+    }
+    // 四周各留 1 像素背景, 保证边界轮廓完整
+    cv::Mat mask = cv::Mat::zeros(bbox.height + 2, bbox.width + 2, CV_8UC1);
+    for (const RUN &run : this->m_runs)
+    {
+        uchar *row = mask.ptr<uchar>(run.row - bbox.y + 1);
+        std::fill(row + run.colStart - bbox.x + 1, row + run.colEnd - bbox.x + 2, static_cast<uchar>(255));
+    }
+    std::vector<cv::Vec4i> hierarchy; // 轮廓层级
+    cv::findContours(mask, this->m_contours, hierarchy, cv::RETR_TREE, cv::CHAIN_APPROX_NONE, cv::Point(bbox.x - 1, bbox.y - 1)); // 计算区域轮廓
+}
+/// @brief 二值化为区域, 直接输出前景游程, 不生成掩膜图像
+/// 与 threshold 的掩膜版本判定一致: 灰度位于 (MinGray, MaxGray] 的像素为前景 (阈值先向下取整)
+/// @param GrayInMat 输入灰度图像
+/// @param OutRegion 输出区域
+/// @param MinGray 区间灰度下限
+/// @param MaxGray 区间灰度上限
+void pcv::threshold(const cv::Mat &GrayInMat, Region &OutRegion, double MinGray, double MaxGray)
+{
+    assert(!GrayInMat.empty() && "Input image is empty");
+    assert(MinGray >= 0 && MinGray <= 255 && "MinGray must be in the range [0, 255]");
+    assert(MaxGray >= 0 && MaxGray <= 255 && "MaxGray must be in the range [0, 255]");
+    if (GrayInMat.type() != CV_8UC1)
+    {
+        CV_Error(cv::Error::StsBadArg, "输入的GrayInMat不是8位灰度图像。");
+    }
+
+    const uchar minGray = cv::saturate_cast<uchar>(cvFloor(MinGray));
+    const uchar maxGray = cv::saturate_cast<uchar>(cvFloor(MaxGray));
+    const int stripeNum = std::min(std::max(1, cv::getNumThreads()) * 4, GrayInMat.rows);
+    std::vector<std::vector<RUN>> stripeRuns(stripeNum);
+    cv::parallel_for_(cv::Range(0, stripeNum), [&](const cv::Range &range) {
+        for (int s = range.start; s < range.end; s++)
+        {
+            int rowBegin = static_cast<int>(static_cast<int64>(GrayInMat.rows) * s / stripeNum);
+            int rowEnd = static_cast<int>(static_cast<int64>(GrayInMat.rows) * (s + 1) / stripeNum);
+            for (int r = rowBegin; r < rowEnd; r++)
+            {
+                extractThresholdRuns(GrayInMat.ptr<uchar>(r), r, GrayInMat.cols, minGray, maxGray, stripeRuns[s]);
+            }
+        }
+    });
+
+    // 条带按行序拼接
+    size_t total = 0;
+    for (const std::vector<RUN> &runs : stripeRuns)
+        total += runs.size();
+    std::vector<RUN> runs;
+    runs.reserve(total);
+    for (const std::vector<RUN> &stripe : stripeRuns)
+        runs.insert(runs.end(), stripe.begin(), stripe.end());
+    OutRegion = Region(std::move(runs), GrayInMat.size());
+}
 /// @brief 连通域分割
 /// @param ThresMat 输入二值化图像
-/// @param OutRegions 输出连通域字典
-int pcv::connection(const cv::Mat &ThresMat, std::unordered_map<int, Region>& OutRegions)
+/// @param OutRegions 输出连通域集合
+int pcv::connection(const cv::Mat &ThresMat, RegionSet& OutRegions)
 {
     OutRegions.clear();
     if (ThresMat.type() != CV_8UC1)
@@ -113,27 +362,56 @@ int pcv::connection(const cv::Mat &ThresMat, std::unordered_map<int, Region>& Ou
         CV_Error(cv::Error::StsBadArg, "输入的ThresMat不是二值化图像。");
     }
 
-    cv::Mat Labels, Stats, Centroids;
-    int RegionNum = cv::connectedComponentsWithStats(ThresMat, Labels, Stats, Centroids);
+    cv::Mat Labels;
+    int RegionNum = cv::connectedComponents(ThresMat, Labels, 8, CV_32S);
 
     if (RegionNum > 1)
     {
-        Eigen::MatrixXi LabelsMat;
-        cv::cv2eigen(Labels, LabelsMat);
+        // 单次扫描标签图, 按标签收集游程
+        std::vector<std::vector<RUN>> runs(RegionNum);
+        for (int r = 0; r < Labels.rows; r++)
+        {
+            const int *row = Labels.ptr<int>(r);
+            int c = 0;
+            while (c < Labels.cols)
+            {
+                int label = row[c];
+                if (label == 0)
+                {
+                    c++;
+                    continue;
+                }
+                int start = c;
+                while (c + 1 < Labels.cols && row[c + 1] == label)
+                    c++;
+                runs[label].push_back({r, start, c});
+                c++;
+            }
+        }
 
+        OutRegions.reserve(RegionNum - 1);
         for (int i = 1; i < RegionNum; i++)
         {
-            Eigen::MatrixXi mask = (LabelsMat.array() == i).cast<int>() * 255;
-            cv::Mat connectedRegion;
-            cv::eigen2cv(mask, connectedRegion);
-            connectedRegion.convertTo(connectedRegion, CV_8U);
-
-            cv::Point2f centroid(static_cast<float>(Centroids.at<double>(i, 0)), static_cast<float>(Centroids.at<double>(i, 1)));
-            OutRegions.emplace(i, pcv::Region(connectedRegion, centroid));
+            OutRegions.push(i, pcv::Region(std::move(runs[i]), ThresMat.size()));
         }
     }
     return RegionNum;
 }
+/// @brief 连通域分割
+/// @param ThresMat 输入二值化图像
+/// @param OutRegions 输出连通域字典
+int pcv::connection(const cv::Mat &ThresMat, std::unordered_map<int, Region>& OutRegions)
+{
+    OutRegions.clear();
+    RegionSet regions;
+    int RegionNum = pcv::connection(ThresMat, regions);
+    OutRegions.reserve(regions.size());
+    for (size_t i = 0; i < regions.size(); i++)
+    {
+        OutRegions.emplace(regions.getLabel(i), regions.takeRegion(i));
+    }
+    return RegionNum;
+}
 /// @brief 获取最大的连通域
 /// @param Regions 连通域字典
 /// @param OutRegion 输出最大的连通域
@@ -183,6 +461,29 @@ void pcv::filterRegionByArea(std::unordered_map<int, pcv::Region> &Regions,
         }
     }
 }
+/// @brief 获取最大的连通域
+/// @param Regions 连通域集合
+/// @param OutRegion 输出最大的连通域 (集合保持不变)
+void pcv::getMaxAreaRegion(RegionSet &Regions, Region& OutRegion)
+{
+    const std::vector<double> &areas = Regions.getAreas();
+    if (areas.empty())
+    {
+        OutRegion = Region();
+        return;
+    }
+    size_t MaxIndex = std::max_element(areas.begin(), areas.end()) - areas.begin();
+    OutRegion = Regions[MaxIndex];
+}
+/// @brief 按照面积筛选区域
+/// @param Regions 连通域集合
+/// @param OutIndices 输出满足条件的区域下标
+/// @param MinArea 最小面积
+/// @param MaxArea 最大面积
+void pcv::filterRegionByArea(RegionSet &Regions, std::vector<int>& OutIndices, float MinArea, float MaxArea)
+{
+    Regions.selectByArea(OutIndices, MinArea, MaxArea);
+}
 /// @brief 计算区域质心
 /// @param Contours 区域轮廓
 /// @param Centroid 质心集合
@@ -201,4 +502,195 @@ void pcv::calcCentroid(const std::vector<std::vector<cv::Point>> &Contours, std:
         mc[i] = cv::Point2f(static_cast<float>(mu[i].m10 / mu[i].m00), static_cast<float>(mu[i].m01 / mu[i].m00)); // 质心的 X,Y 坐标：(m10/m00, m01/m00)
     }
     Centroid = std::move(mc);
+}
+/// @brief 由游程计算区域矩
+/// @param Runs 区域游程
+/// @param OutMoments 输出区域矩 (最高三阶)
+void pcv::calcRunMoments(const std::vector<RUN> &Runs, cv::Moments &OutMoments)
+{
+    double m00 = 0, m10 = 0, m01 = 0, m20 = 0, m11 = 0, m02 = 0, m30 = 0, m21 = 0, m12 = 0, m03 = 0;
+    for (const RUN &run : Runs)
+    {
+        // 每个游程内 x 的各阶幂和有闭式解
+        double a = run.colStart - 1, b = run.colEnd;
+        double y = run.row;
+        double n = b - a;
+        double s1 = powerSum1(b) - powerSum1(a);
+        double s2 = powerSum2(b) - powerSum2(a);
+        double s3 = powerSum3(b) - powerSum3(a);
+        m00 += n;
+        m10 += s1;
+        m01 += y * n;
+        m20 += s2;
+        m11 += y * s1;
+        m02 += y * y * n;
+        m30 += s3;
+        m21 += y * s2;
+        m12 += y * y * s1;
+        m03 += y * y * y * n;
+    }
+    OutMoments = cv::Moments(m00, m10, m01, m20, m11, m02, m30, m21, m12, m03);
+}
+/// @brief 清空区域集合
+void pcv::RegionSet::clear()
+{
+    this->m_regions.clear();
+    this->m_labels.clear();
+    this->m_areas.clear();
+    this->m_boundingRects.clear();
+    this->m_circularities.clear();
+    this->m_version++;
+}
+/// @brief 交换两个集合 (含已计算的特征列)
+/// @param Other 另一个集合
+void pcv::RegionSet::swap(RegionSet &Other)
+{
+    this->m_regions.swap(Other.m_regions);
+    this->m_labels.swap(Other.m_labels);
+    this->m_areas.swap(Other.m_areas);
+    this->m_boundingRects.swap(Other.m_boundingRects);
+    this->m_circularities.swap(Other.m_circularities);
+    std::swap(this->m_version, Other.m_version);
+    std::swap(this->m_areasVersion, Other.m_areasVersion);
+    std::swap(this->m_boundingRectsVersion, Other.m_boundingRectsVersion);
+    std::swap(this->m_circularitiesVersion, Other.m_circularitiesVersion);
+}
+/// @brief 预分配空间
+/// @param Num 区域数量
+void pcv::RegionSet::reserve(size_t Num)
+{
+    this->m_regions.reserve(Num);
+    this->m_labels.reserve(Num);
+}
+/// @brief 追加区域
+/// @param Label 区域标签, 需大于集合中已有的标签
+/// @param InRegion 区域
+void pcv::RegionSet::push(int Label, Region &&InRegion)
+{
+    assert((this->m_labels.empty() || Label > this->m_labels.back()) && "Labels must be increasing");
+    this->m_regions.push_back(std::move(InRegion));
+    this->m_labels.push_back(Label);
+    this->m_version++;
+}
+/// @brief 替换区域, 标签保持不变, 特征列随之失效
+/// @param Index 区域下标
+/// @param InRegion 新区域
+void pcv::RegionSet::setRegion(size_t Index, Region &&InRegion)
+{
+    assert(Index < this->m_regions.size() && "Index out of range");
+    this->m_regions[Index] = std::move(InRegion);
+    this->m_version++;
+}
+/// @brief 移出区域, 原位置留下空区域, 特征列随之失效
+/// @param Index 区域下标
+/// @return 移出的区域
+pcv::Region pcv::RegionSet::takeRegion(size_t Index)
+{
+    assert(Index < this->m_regions.size() && "Index out of range");
+    Region region = std::move(this->m_regions[Index]);
+    this->m_regions[Index] = Region();
+    this->m_version++;
+    return region;
+}
+/// @brief 按标签查找区域下标
+/// @param Label 区域标签
+/// @return 区域下标, 不存在时返回 -1
+int pcv::RegionSet::findIndex(int Label) const
+{
+    auto it = std::lower_bound(this->m_labels.begin(), this->m_labels.end(), Label);
+    if (it == this->m_labels.end() || *it != Label)
+    {
+        return -1;
+    }
+    return static_cast<int>(it - this->m_labels.begin());
+}
+/// @brief 获取面积列, 区域被替换或增删后重新计算
+/// @return 各区域面积
+const std::vector<double> &pcv::RegionSet::getAreas()
+{
+    if (this->m_areasVersion != this->m_version || this->m_areas.size() != this->m_regions.size())
+    {
+        this->m_areasVersion = this->m_version;
+        this->m_areas.resize(this->m_regions.size());
+        for (size_t i = 0; i < this->m_regions.size(); i++)
+        {
+            this->m_areas[i] = this->m_regions[i].getRegionArea();
+        }
+    }
+    return this->m_areas;
+}
+/// @brief 获取外接矩形列
+/// @return 各区域外接矩形
+const std::vector<cv::Rect> &pcv::RegionSet::getBoundingRects()
+{
+    if (this->m_boundingRectsVersion != this->m_version || this->m_boundingRects.size() != this->m_regions.size())
+    {
+        this->m_boundingRectsVersion = this->m_version;
+        this->m_boundingRects.resize(this->m_regions.size());
+        for (size_t i = 0; i < this->m_regions.size(); i++)
+        {
+            this->m_boundingRects[i] = this->m_regions[i].getBoundingRect();
+        }
+    }
+    return this->m_boundingRects;
+}
+/// @brief 获取圆度列
+/// @return 各区域圆度
+const std::vector<double> &pcv::RegionSet::getCircularities()
+{
+    if (this->m_circularitiesVersion != this->m_version || this->m_circularities.size() != this->m_regions.size())
+    {
+        this->m_circularitiesVersion = this->m_version;
+        this->m_circularities.resize(this->m_regions.size());
+        for (size_t i = 0; i < this->m_regions.size(); i++)
+        {
+            this->m_circularities[i] = this->m_regions[i].getCircularity();
+        }
+    }
+    return this->m_circularities;
+}
+/// @brief 按面积筛选区域
+/// @param OutIndices 输出满足条件的区域下标
+/// @param MinArea 最小面积
+/// @param MaxArea 最大面积
+void pcv::RegionSet::selectByArea(std::vector<int> &OutIndices, double MinArea, double MaxArea)
+{
+    const std::vector<double> &areas = this->getAreas();
+    selectAll(static_cast<int>(areas.size()), OutIndices, [&](int i) { return areas[i] >= MinArea && areas[i] <= MaxArea; });
+}
+/// @brief 在给定下标中按面积筛选区域 (InIndices 与 OutIndices 可以是同一对象)
+void pcv::RegionSet::selectByArea(const std::vector<int> &InIndices, std::vector<int> &OutIndices, double MinArea, double MaxArea)
+{
+    const std::vector<double> &areas = this->getAreas();
+    selectFrom(InIndices, OutIndices, [&](int i) { return areas[i] >= MinArea && areas[i] <= MaxArea; });
+}
+/// @brief 按外接矩形尺寸筛选区域
+/// @param OutIndices 输出满足条件的区域下标
+/// @param MinSize 最小宽高
+/// @param MaxSize 最大宽高
+void pcv::RegionSet::selectByBoundingRect(std::vector<int> &OutIndices, const cv::Size &MinSize, const cv::Size &MaxSize)
+{
+    const std::vector<cv::Rect> &rects = this->getBoundingRects();
+    selectAll(static_cast<int>(rects.size()), OutIndices, [&](int i) { return inSizeRange(rects[i], MinSize, MaxSize); });
+}
+/// @brief 在给定下标中按外接矩形尺寸筛选区域 (InIndices 与 OutIndices 可以是同一对象)
+void pcv::RegionSet::selectByBoundingRect(const std::vector<int> &InIndices, std::vector<int> &OutIndices, const cv::Size &MinSize, const cv::Size &MaxSize)
+{
+    const std::vector<cv::Rect> &rects = this->getBoundingRects();
+    selectFrom(InIndices, OutIndices, [&](int i) { return inSizeRange(rects[i], MinSize, MaxSize); });
+}
+/// @brief 按圆度筛选区域
+/// @param OutIndices 输出满足条件的区域下标
+/// @param MinCircularity 最小圆度
+/// @param MaxCircularity 最大圆度
+void pcv::RegionSet::selectByCircularity(std::vector<int> &OutIndices, double MinCircularity, double MaxCircularity)
+{
+    const std::vector<double> &circularities = this->getCircularities();
+    selectAll(static_cast<int>(circularities.size()), OutIndices, [&](int i) { return circularities[i] >= MinCircularity && circularities[i] <= MaxCircularity; });
+}
+/// @brief 在给定下标中按圆度筛选区域 (InIndices 与 OutIndices 可以是同一对象)
+void pcv::RegionSet::selectByCircularity(const std::vector<int> &InIndices, std::vector<int> &OutIndices, double MinCircularity, double MaxCircularity)
+{
+    const std::vector<double> &circularities = this->getCircularities();
+    selectFrom(InIndices, OutIndices, [&](int i) { return circularities[i] >= MinCircularity && circularities[i] <= MaxCircularity; });
 }
\ No newline at end of file
@@ -1,42 +1,112 @@
 #ifndef H_PCV_REGION
 #define H_PCV_REGION
 
+#include <cstdint>
 #include <opencv2/core.hpp>
 #include <unordered_map>
+#include <vector>
 #include "cv_core.h"
 
 namespace pcv
 {
+    /// @brief 游程 (同一行内连续的前景像素, 列区间为闭区间 [colStart, colEnd])
+    struct RUN
+    {
+        int row;
+        int colStart;
+        int colEnd;
+    };
+
     class Region
     {
     public:
         Region() = default;
         explicit Region(const cv::Mat &InMat, const cv::Point2f &Centroid);
         explicit Region(const cv::Mat &InMat) : Region(InMat, cv::Point2f(0.0f, 0.0f)) {}
+        explicit Region(std::vector<RUN> Runs, const cv::Size &Size); // 游程需按 (row, colStart) 升序且互不重叠
         ~Region() = default;
 
         cv::Size getMatSize() const;          // 获取原始图像尺寸
-        void getRegion(cv::Mat& RegionMat);   // 获取区域
-        double getRegionArea();               // 获取区域面积
-        cv::Point2f getCentroid();            // 获取区域质心
-        cv::Rect getBoundingRect();           // 获取区域的外接矩形
-        cv::RotatedRect getMinBoundingRect(); // 获取区域的最小外接矩形
-        double getMinBoundingRectArea();      // 获取最小外接矩形面积
-        void getContours(std::vector<std::vector<cv::Point>>& OutContours); // 获取区域轮廓
+        void getRegion(cv::Mat& RegionMat) const;   // 获取区域
+        double getRegionArea() const;               // 获取区域面积
+        cv::Point2f getCentroid() const;            // 获取区域质心
+        cv::Rect getBoundingRect() const;           // 获取区域的外接矩形
+        cv::RotatedRect getMinBoundingRect() const; // 获取区域的最小外接矩形
+        double getMinBoundingRectArea() const;      // 获取最小外接矩形面积
+        double getCircularity() const;              // 获取区域圆度
+        cv::Moments getMoments() const;             // 获取区域矩
+        void getContours(std::vector<std::vector<cv::Point>>& OutContours) const; // 获取区域轮廓
+        const std::vector<RUN>& getRuns() const { return this->m_runs; }          // 获取区域游程
     private:
-        int m_width;
-        int m_height;
+        void calcContours() const; // 由游程计算轮廓
+
+        int m_width = 0;
+        int m_height = 0;
+
+        std::vector<RUN> m_runs; // 区域游程
+        // 以下为按需计算的特征缓存, 不改变区域本身
+        mutable std::vector<std::vector<cv::Point>> m_contours; // 区域轮廓
+        mutable cv::Point2f m_centroid;                         // 区域质心
+        mutable cv::Moments m_moments;                          // 区域矩
+        mutable cv::Rect m_boundingRect;                        // 外接矩形
+        mutable cv::RotatedRect m_minBoundingRect;              // 最小外接矩形
+
+        mutable double m_regionArea = 0.0;          // 区域面积
+        mutable double m_minBoundingRectArea = 0.0; // 最小外接矩形面积
+        mutable double m_circularity = 0.0;         // 圆度
+        mutable bool m_hasCentroid = false;         // 质心是否已计算
+        mutable bool m_hasContours = false;         // 轮廓是否已计算
+    };
+
+    /// @brief 连续存储的区域集合, 按标签升序保存, 标签在集合生命周期内保持不变
+    /// 区域只能以 const 方式读取, 修改须通过 setRegion / takeRegion, 以便特征列随之失效
+    class RegionSet
+    {
+    public:
+        RegionSet() = default;
+        ~RegionSet() = default;
+
+        void clear();                                   // 清空集合
+        void reserve(size_t Num);                       // 预分配空间
+        void push(int Label, Region &&InRegion);        // 追加区域 (标签需递增)
+        void swap(RegionSet &Other);                    // 交换两个集合
+        size_t size() const { return this->m_regions.size(); }
+        bool empty() const { return this->m_regions.empty(); }
+        const Region &operator[](size_t Index) const { return this->m_regions[Index]; }
+        void setRegion(size_t Index, Region &&InRegion); // 替换区域 (标签不变)
+        Region takeRegion(size_t Index);                 // 移出区域, 原位置留下空区域
+        int getLabel(size_t Index) const { return this->m_labels[Index]; } // 获取区域标签
+        int findIndex(int Label) const;                 // 按标签查找下标, 不存在时返回 -1
+        std::vector<Region>::const_iterator begin() const { return this->m_regions.begin(); }
+        std::vector<Region>::const_iterator end() const { return this->m_regions.end(); }
 
-        std::vector<std::vector<cv::Point>> m_contours; // 区域轮廓
-        cv::Point2f m_centroid;                         // 区域质心
-        // cv::Mat m_region;                               // 掩膜区域CV_8UC1
-        cv::Rect m_boundingRect;                        // 外接矩形
-        cv::RotatedRect m_minBoundingRect;              // 最小外接矩形
+        const std::vector<double> &getAreas();               // 面积列
+        const std::vector<cv::Rect> &getBoundingRects();     // 外接矩形列
+        const std::vector<double> &getCircularities();       // 圆度列
 
-        double m_regionArea;          // 区域面积
-        double m_minBoundingRectArea; // 最小外接矩形面积
+        void selectByArea(std::vector<int> &OutIndices, double MinArea, double MaxArea);                              // 按面积筛选
+        void selectByArea(const std::vector<int> &InIndices, std::vector<int> &OutIndices, double MinArea, double MaxArea);
+        void selectByBoundingRect(std::vector<int> &OutIndices, const cv::Size &MinSize, const cv::Size &MaxSize);    // 按外接矩形尺寸筛选
+        void selectByBoundingRect(const std::vector<int> &InIndices, std::vector<int> &OutIndices, const cv::Size &MinSize, const cv::Size &MaxSize);
+        void selectByCircularity(std::vector<int> &OutIndices, double MinCircularity, double MaxCircularity);         // 按圆度筛选
+        void selectByCircularity(const std::vector<int> &InIndices, std::vector<int> &OutIndices, double MinCircularity, double MaxCircularity);
+    private:
+        std::vector<Region> m_regions;          // 区域
+        std::vector<int> m_labels;              // 区域标签
+        std::vector<double> m_areas;            // 面积列 (按需计算)
+        std::vector<cv::Rect> m_boundingRects;  // 外接矩形列 (按需计算)
+        std::vector<double> m_circularities;    // 圆度列 (按需计算)
+        uint64_t m_version = 1;                 // 区域被替换或增删时递增
+        uint64_t m_areasVersion = 0;            // 各特征列计算时的版本
+        uint64_t m_boundingRectsVersion = 0;
+        uint64_t m_circularitiesVersion = 0;
     };
 
+    void threshold(const cv::Mat &GrayInMat, Region &OutRegion, double MinGray, double MaxGray); // 二值化为区域, 不生成掩膜
+    int connection(const cv::Mat &ThresMat, RegionSet& OutRegions);                          // 分割连通域
+    void getMaxAreaRegion(RegionSet &Regions, Region& OutRegion);                             // 获取最大的连通域
+    void filterRegionByArea(RegionSet &Regions, std::vector<int>& OutIndices,
+                            float MinArea, float MaxArea = 1e10f);                           // 根据面积过滤连通域, 输出下标
     int connection(const cv::Mat &ThresMat, std::unordered_map<int, Region>& OutRegions);   // 分割连通域
     void getMaxAreaRegion(std::unordered_map<int, Region> &Regions, Region& OutRegion);      // 获取最大的连通域
     void filterRegionByArea(std::unordered_map<int, Region> &Regions, 
@@ -44,5 +114,6 @@ namespace pcv
                             float MinArea, 
                             float MaxArea = 1e10f);                                          // 根据面积过滤连通域
     void calcCentroid(const std::vector<std::vector<cv::Point>> &Contours, std::vector<cv::Point2f>& Centroid);    // 计算区域质心
+    void calcRunMoments(const std::vector<RUN> &Runs, cv::Moments &OutMoments);               // 由游程计算区域矩
 }; // namespace pcv
 #endif // H_PCV_REGION
\ No newline at end of file
@@ -0,0 +1,153 @@
+#include "cv_region_features.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <opencv2/imgproc.hpp>
+
+namespace
+{
+    /// @brief 0..k 的幂和, k 可以为 -1 (空和)
+    inline double powerSum1(double k) { return k * (k + 1) / 2; }
+    inline double powerSum2(double k) { return k * (k + 1) * (2 * k + 1) / 6; }
+} // namespace
+
+/// @brief 按标签数重置特征表
+/// @param Num 标签数 (含背景)
+void pcv::REGION_FEATURES::resize(int Num)
+{
+    this->LabelNum = Num;
+    for (std::vector<double> *column : {&Area, &M10, &M01, &M20, &M11, &M02, &Mu20, &Mu11, &Mu02,
+                                        &Orientation, &Eccentricity, &Perimeter, &Convexity})
+    {
+        column->assign(Num, 0.0);
+    }
+    this->BoundingRect.assign(Num, cv::Rect());
+    this->Centroid.assign(Num, cv::Point2f());
+}
+
+/// @brief 单次光栅扫描计算所有标签的区域特征
+/// @param Labels 标签图像(CV_32SC1), 0 为背景
+/// @param LabelNum 标签数 (含背景), 非正数时由标签图像的最大值确定
+/// @param Features 输出区域特征表
+void pcv::calcRegionFeatures(const cv::Mat &Labels, int LabelNum, REGION_FEATURES &Features)
+{
+    assert(!Labels.empty() && "Input labels is empty");
+    if (Labels.type() != CV_32SC1)
+    {
+        CV_Error(cv::Error::StsBadArg, "输入的Labels不是CV_32SC1标签图像。");
+    }
+    if (LabelNum <= 0)
+    {
+        double maxVal = 0;
+        cv::minMaxLoc(Labels, nullptr, &maxVal);
+        LabelNum = static_cast<int>(maxVal) + 1;
+    }
+    Features.resize(LabelNum);
+
+    // 外接矩形以 (left, top, right, bottom) 累积
+    std::vector<cv::Vec4i> bounds(LabelNum, cv::Vec4i(INT_MAX, INT_MAX, -1, -1));
+    // 游程端点所在像素的四个角点, 用于计算凸包
+    std::vector<std::vector<cv::Point>> corners(LabelNum);
+
+    const int rows = Labels.rows;
+    const int cols = Labels.cols;
+    for (int r = 0; r < rows; r++)
+    {
+        const int *row = Labels.ptr<int>(r);
+        const int *prev = r > 0 ? Labels.ptr<int>(r - 1) : nullptr;
+
+        // 上下方向的像素边界
+        for (int c = 0; c < cols; c++)
+        {
+            int up = prev ? prev[c] : 0;
+            if (row[c] != up)
+            {
+                if (row[c] > 0)
+                    Features.Perimeter[row[c]] += 1;
+                if (up > 0)
+                    Features.Perimeter[up] += 1;
+            }
+        }
+        if (r == rows - 1)
+        {
+            for (int c = 0; c < cols; c++)
+            {
+                if (row[c] > 0)
+                    Features.Perimeter[row[c]] += 1;
+            }
+        }
+
+        // 逐游程累积面积、矩、外接矩形
+        int c = 0;
+        while (c < cols)
+        {
+            int label = row[c];
+            int start = c;
+            while (c + 1 < cols && row[c + 1] == label)
+                c++;
+            int end = c;
+            c++;
+            if (label <= 0)
+                continue;
+            CV_Assert(label < LabelNum);
+
+            double n = end - start + 1;
+            double s1 = powerSum1(end) - powerSum1(start - 1);
+            double s2 = powerSum2(end) - powerSum2(start - 1);
+            double y = r;
+            Features.Area[label] += n;
+            Features.M10[label] += s1;
+            Features.M01[label] += y * n;
+            Features.M20[label] += s2;
+            Features.M11[label] += y * s1;
+            Features.M02[label] += y * y * n;
+            Features.Perimeter[label] += 2; // 游程左右两侧的像素边界
+
+            cv::Vec4i &b = bounds[label];
+            b[0] = std::min(b[0], start);
+            b[1] = std::min(b[1], r);
+            b[2] = std::max(b[2], end);
+            b[3] = std::max(b[3], r);
+
+            std::vector<cv::Point> &pts = corners[label];
+            pts.emplace_back(start, r);
+            pts.emplace_back(end + 1, r);
+            pts.emplace_back(start, r + 1);
+            pts.emplace_back(end + 1, r + 1);
+        }
+    }
+
+    // 由累积量导出其余特征
+    std::vector<cv::Point> hull;
+    for (int i = 1; i < LabelNum; i++)
+    {
+        double m00 = Features.Area[i];
+        if (m00 <= 0)
+            continue;
+        const cv::Vec4i &b = bounds[i];
+        Features.BoundingRect[i] = cv::Rect(b[0], b[1], b[2] - b[0] + 1, b[3] - b[1] + 1);
+
+        double cx = Features.M10[i] / m00;
+        double cy = Features.M01[i] / m00;
+        Features.Centroid[i] = cv::Point2f(static_cast<float>(cx), static_cast<float>(cy));
+
+        double mu20 = Features.M20[i] - cx * Features.M10[i];
+        double mu11 = Features.M11[i] - cx * Features.M01[i];
+        double mu02 = Features.M02[i] - cy * Features.M01[i];
+        Features.Mu20[i] = mu20;
+        Features.Mu11[i] = mu11;
+        Features.Mu02[i] = mu02;
+        Features.Orientation[i] = 0.5 * std::atan2(2 * mu11, mu20 - mu02);
+
+        // 协方差矩阵特征值
+        double half = (mu20 + mu02) / 2;
+        double delta = std::sqrt((mu20 - mu02) * (mu20 - mu02) / 4 + mu11 * mu11);
+        double lambda1 = half + delta;
+        double lambda2 = half - delta;
+        Features.Eccentricity[i] = lambda1 > 0 ? std::sqrt(std::max(0.0, 1 - lambda2 / lambda1)) : 0.0;
+
+        cv::convexHull(corners[i], hull);
+        double hullArea = cv::contourArea(hull);
+        Features.Convexity[i] = hullArea > 0 ? std::min(1.0, m00 / hullArea) : 1.0;
+    }
+}
@@ -0,0 +1,29 @@
+#ifndef H_PCV_REGION_FEATURES
+#define H_PCV_REGION_FEATURES
+
+#include <opencv2/core.hpp>
+#include <vector>
+
+namespace pcv
+{
+    /// @brief 区域特征表 (列式存储, 第 i 行对应标签 i, 第 0 行为背景且不计算)
+    struct REGION_FEATURES
+    {
+        int LabelNum = 0;                     // 标签数 (含背景)
+        std::vector<double> Area;             // 面积 (像素数, 即 m00)
+        std::vector<double> M10, M01;         // 一阶原点矩
+        std::vector<double> M20, M11, M02;    // 二阶原点矩
+        std::vector<double> Mu20, Mu11, Mu02; // 二阶中心矩
+        std::vector<cv::Rect> BoundingRect;   // 外接矩形
+        std::vector<cv::Point2f> Centroid;    // 质心
+        std::vector<double> Orientation;      // 主轴方向 (弧度, [-pi/2, pi/2])
+        std::vector<double> Eccentricity;     // 离心率 [0, 1)
+        std::vector<double> Perimeter;        // 周长 (像素边界长度)
+        std::vector<double> Convexity;        // 凸性 (面积 / 凸包面积)
+
+        void resize(int Num);
+    };
+
+    void calcRegionFeatures(const cv::Mat &Labels, int LabelNum, REGION_FEATURES &Features); // 单次扫描计算所有标签的区域特征
+}; // namespace pcv
+#endif // H_PCV_REGION_FEATURES
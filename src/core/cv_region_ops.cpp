@@ -0,0 +1,582 @@
+#include "cv_region_ops.h"
+#include <algorithm>
+#include <cmath>
+#include "cv_labeling.h"
+
+namespace
+{
+    /// @brief 结构元素的一行: 相对锚点的行偏移与列区间 [dxStart, dxEnd]
+    struct SE_ROW
+    {
+        int dy;
+        int dxStart;
+        int dxEnd;
+    };
+
+    /// @brief 矩形结构元素的水平部分 (锚点与 cv::getStructuringElement 一致, 位于 (Width / 2, Height / 2))
+    std::vector<SE_ROW> rectangleRowSE(int Width)
+    {
+        return {{0, -(Width / 2), Width - 1 - Width / 2}};
+    }
+
+    /// @brief 矩形结构元素的竖直部分
+    std::vector<SE_ROW> rectangleColumnSE(int Height)
+    {
+        std::vector<SE_ROW> se;
+        for (int dy = -(Height / 2); dy <= Height - 1 - Height / 2; dy++)
+        {
+            se.push_back({dy, 0, 0});
+        }
+        return se;
+    }
+
+    /// @brief 圆形结构元素, 包含到中心距离不超过 Radius 的像素
+    std::vector<SE_ROW> circleSE(double Radius)
+    {
+        std::vector<SE_ROW> se;
+        int r = static_cast<int>(std::floor(Radius));
+        for (int dy = -r; dy <= r; dy++)
+        {
+            int half = static_cast<int>(std::floor(std::sqrt(Radius * Radius - dy * dy)));
+            se.push_back({dy, -half, half});
+        }
+        return se;
+    }
+
+    /// @brief 关于锚点对称的结构元素
+    std::vector<SE_ROW> reflectSE(const std::vector<SE_ROW> &Se)
+    {
+        std::vector<SE_ROW> reflected;
+        reflected.reserve(Se.size());
+        for (auto it = Se.rbegin(); it != Se.rend(); ++it)
+        {
+            reflected.push_back({-it->dy, -it->dxEnd, -it->dxStart});
+        }
+        return reflected;
+    }
+
+    /// @brief 排序并合并重叠或相邻的游程
+    void normalizeRuns(std::vector<pcv::RUN> &Runs)
+    {
+        std::sort(Runs.begin(), Runs.end(), [](const pcv::RUN &a, const pcv::RUN &b) {
+            return a.row != b.row ? a.row < b.row : a.colStart < b.colStart;
+        });
+        size_t num = 0;
+        for (const pcv::RUN &run : Runs)
+        {
+            if (num > 0 && Runs[num - 1].row == run.row && run.colStart <= Runs[num - 1].colEnd + 1)
+            {
+                Runs[num - 1].colEnd = std::max(Runs[num - 1].colEnd, run.colEnd);
+            }
+            else
+            {
+                Runs[num++] = run;
+            }
+        }
+        Runs.resize(num);
+    }
+
+    /// @brief 将游程裁剪到图像范围内
+    void clipRuns(std::vector<pcv::RUN> &Runs, const cv::Size &Size)
+    {
+        size_t num = 0;
+        for (const pcv::RUN &run : Runs)
+        {
+            if (run.row < 0 || run.row >= Size.height)
+                continue;
+            int start = std::max(run.colStart, 0);
+            int end = std::min(run.colEnd, Size.width - 1);
+            if (start <= end)
+                Runs[num++] = {run.row, start, end};
+        }
+        Runs.resize(num);
+    }
+
+    /// @brief 膨胀: 各结构元素行平移扩展后的游程之并
+    void dilateRuns(const std::vector<pcv::RUN> &In, const std::vector<SE_ROW> &Se, std::vector<pcv::RUN> &Out)
+    {
+        std::vector<pcv::RUN> runs;
+        runs.reserve(In.size() * Se.size());
+        for (const pcv::RUN &run : In)
+        {
+            for (const SE_ROW &se : Se)
+            {
+                runs.push_back({run.row + se.dy, run.colStart + se.dxStart, run.colEnd + se.dxEnd});
+            }
+        }
+        normalizeRuns(runs);
+        Out.swap(runs);
+    }
+
+    /// @brief 两组有序且互不重叠的列区间求交
+    void intersectIntervals(const std::vector<pcv::RUN> &A, const std::vector<pcv::RUN> &B, std::vector<pcv::RUN> &Out)
+    {
+        Out.clear();
+        size_t i = 0, j = 0;
+        while (i < A.size() && j < B.size())
+        {
+            int start = std::max(A[i].colStart, B[j].colStart);
+            int end = std::min(A[i].colEnd, B[j].colEnd);
+            if (start <= end)
+                Out.push_back({A[i].row, start, end});
+            if (A[i].colEnd < B[j].colEnd)
+                i++;
+            else
+                j++;
+        }
+    }
+
+    /// @brief 腐蚀: 各结构元素行对应的收缩游程之交
+    /// 只有当结构元素首行落在已有游程的行上时输出行才可能非空, 因此只遍历这些行。
+    void erodeRuns(const std::vector<pcv::RUN> &In, const std::vector<SE_ROW> &Se, std::vector<pcv::RUN> &Out)
+    {
+        std::vector<pcv::RUN> result;
+        if (In.empty() || Se.empty())
+        {
+            Out.swap(result);
+            return;
+        }
+
+        // 第 r 行游程为 [rowStart[r - minRow], rowStart[r - minRow + 1])
+        const int minRow = In.front().row;
+        const int maxRow = In.back().row;
+        std::vector<int> rowStart(maxRow - minRow + 2, 0);
+        for (const pcv::RUN &run : In)
+        {
+            rowStart[run.row - minRow + 1]++;
+        }
+        for (size_t r = 1; r < rowStart.size(); r++)
+        {
+            rowStart[r] += rowStart[r - 1];
+        }
+
+        std::vector<pcv::RUN> cur, shrunk, next;
+        auto shrinkRow = [&](int Row, int OutRow, const SE_ROW &se, std::vector<pcv::RUN> &Dst) {
+            Dst.clear();
+            if (Row < minRow || Row > maxRow)
+                return;
+            for (int k = rowStart[Row - minRow]; k < rowStart[Row - minRow + 1]; k++)
+            {
+                int start = In[k].colStart - se.dxStart;
+                int end = In[k].colEnd - se.dxEnd;
+                if (start <= end)
+                    Dst.push_back({OutRow, start, end});
+            }
+        };
+
+        for (int r = minRow; r <= maxRow; r++)
+        {
+            if (rowStart[r - minRow] == rowStart[r - minRow + 1])
+                continue;
+            int y = r - Se[0].dy;
+            shrinkRow(r, y, Se[0], cur);
+            for (size_t k = 1; k < Se.size() && !cur.empty(); k++)
+            {
+                shrinkRow(y + Se[k].dy, y, Se[k], shrunk);
+                intersectIntervals(cur, shrunk, next);
+                cur.swap(next);
+            }
+            result.insert(result.end(), cur.begin(), cur.end());
+        }
+        Out.swap(result);
+    }
+
+    /// @brief 矩形腐蚀, 与 cv::erode 的约定一致: 输出像素要求以其为锚点的结构元素全部落在区域内
+    void erodeRectangle(const std::vector<pcv::RUN> &In, int Width, int Height, std::vector<pcv::RUN> &Out)
+    {
+        erodeRuns(In, rectangleRowSE(Width), Out);
+        erodeRuns(Out, rectangleColumnSE(Height), Out);
+    }
+
+    /// @brief 矩形膨胀, 与 cv::dilate 的约定一致: 按对称后的结构元素扩展 (偶数尺寸时锚点不在中心)
+    void dilateRectangle(const std::vector<pcv::RUN> &In, int Width, int Height, std::vector<pcv::RUN> &Out)
+    {
+        dilateRuns(In, reflectSE(rectangleRowSE(Width)), Out);
+        dilateRuns(Out, reflectSE(rectangleColumnSE(Height)), Out);
+    }
+
+    /// @brief 两组游程的并集
+    void unionRuns(const std::vector<pcv::RUN> &A, const std::vector<pcv::RUN> &B, std::vector<pcv::RUN> &Out)
+    {
+        std::vector<pcv::RUN> runs(A.size() + B.size());
+        std::merge(A.begin(), A.end(), B.begin(), B.end(), runs.begin(), [](const pcv::RUN &a, const pcv::RUN &b) {
+            return a.row != b.row ? a.row < b.row : a.colStart < b.colStart;
+        });
+        normalizeRuns(runs);
+        Out.swap(runs);
+    }
+
+    /// @brief 两组游程的交集: 按 (row, col) 字典序双指针推进
+    void intersectRuns(const std::vector<pcv::RUN> &A, const std::vector<pcv::RUN> &B, std::vector<pcv::RUN> &Out)
+    {
+        std::vector<pcv::RUN> runs;
+        size_t i = 0, j = 0;
+        while (i < A.size() && j < B.size())
+        {
+            const pcv::RUN &a = A[i];
+            const pcv::RUN &b = B[j];
+            if (a.row < b.row)
+            {
+                i++;
+                continue;
+            }
+            if (b.row < a.row)
+            {
+                j++;
+                continue;
+            }
+            int start = std::max(a.colStart, b.colStart);
+            int end = std::min(a.colEnd, b.colEnd);
+            if (start <= end)
+                runs.push_back({a.row, start, end});
+            if (a.colEnd < b.colEnd)
+                i++;
+            else
+                j++;
+        }
+        Out.swap(runs);
+    }
+
+    /// @brief 两组游程的差集 A - B
+    void subtractRuns(const std::vector<pcv::RUN> &A, const std::vector<pcv::RUN> &B, std::vector<pcv::RUN> &Out)
+    {
+        std::vector<pcv::RUN> runs;
+        size_t j = 0;
+        for (const pcv::RUN &a : A)
+        {
+            // 跳过位于 a 之前的 B 游程, 它们也位于 A 后续游程之前
+            while (j < B.size() && (B[j].row < a.row || (B[j].row == a.row && B[j].colEnd < a.colStart)))
+                j++;
+            int start = a.colStart;
+            for (size_t k = j; k < B.size() && B[k].row == a.row && B[k].colStart <= a.colEnd; k++)
+            {
+                if (B[k].colStart > start)
+                    runs.push_back({a.row, start, B[k].colStart - 1});
+                start = std::max(start, B[k].colEnd + 1);
+            }
+            if (start <= a.colEnd)
+                runs.push_back({a.row, start, a.colEnd});
+        }
+        Out.swap(runs);
+    }
+
+    void checkSameSize(const pcv::Region &Region1, const pcv::Region &Region2)
+    {
+        if (Region1.getMatSize() != Region2.getMatSize())
+        {
+            CV_Error(cv::Error::StsBadArg, "两个区域的图像尺寸不一致。");
+        }
+    }
+
+    void checkRectangle(int Width, int Height)
+    {
+        if (Width < 1 || Height < 1)
+        {
+            CV_Error(cv::Error::StsBadArg, "结构元素的Width和Height必须为正数。");
+        }
+    }
+
+    void checkRadius(double Radius)
+    {
+        if (!(Radius >= 0.5))
+        {
+            CV_Error(cv::Error::StsBadArg, "结构元素的Radius不能小于0.5。");
+        }
+    }
+} // namespace
+
+/// @brief 矩形腐蚀 (先按行再按列分解计算)
+/// @param InRegion 输入区域
+/// @param OutRegion 输出区域, 可与输入为同一对象
+/// @param Width 结构元素宽度
+/// @param Height 结构元素高度
+void pcv::erosionRectangle(const Region &InRegion, Region &OutRegion, int Width, int Height)
+{
+    checkRectangle(Width, Height);
+    std::vector<RUN> runs;
+    erodeRectangle(InRegion.getRuns(), Width, Height, runs);
+    OutRegion = Region(std::move(runs), InRegion.getMatSize());
+}
+/// @brief 矩形膨胀 (先按行再按列分解计算)
+/// @param InRegion 输入区域
+/// @param OutRegion 输出区域, 可与输入为同一对象
+/// @param Width 结构元素宽度
+/// @param Height 结构元素高度
+void pcv::dilationRectangle(const Region &InRegion, Region &OutRegion, int Width, int Height)
+{
+    checkRectangle(Width, Height);
+    std::vector<RUN> runs;
+    dilateRectangle(InRegion.getRuns(), Width, Height, runs);
+    clipRuns(runs, InRegion.getMatSize());
+    OutRegion = Region(std::move(runs), InRegion.getMatSize());
+}
+/// @brief 矩形开运算 (先腐蚀再膨胀)
+/// @param InRegion 输入区域
+/// @param OutRegion 输出区域, 可与输入为同一对象
+/// @param Width 结构元素宽度
+/// @param Height 结构元素高度
+void pcv::openingRectangle(const Region &InRegion, Region &OutRegion, int Width, int Height)
+{
+    checkRectangle(Width, Height);
+    std::vector<RUN> runs;
+    erodeRectangle(InRegion.getRuns(), Width, Height, runs);
+    dilateRectangle(runs, Width, Height, runs);
+    clipRuns(runs, InRegion.getMatSize());
+    OutRegion = Region(std::move(runs), InRegion.getMatSize());
+}
+/// @brief 矩形闭运算 (先膨胀再腐蚀)
+/// 中间结果不裁剪, 因此贴近图像边界的区域不会被腐蚀掉。
+/// @param InRegion 输入区域
+/// @param OutRegion 输出区域, 可与输入为同一对象
+/// @param Width 结构元素宽度
+/// @param Height 结构元素高度
+void pcv::closingRectangle(const Region &InRegion, Region &OutRegion, int Width, int Height)
+{
+    checkRectangle(Width, Height);
+    std::vector<RUN> runs;
+    dilateRectangle(InRegion.getRuns(), Width, Height, runs);
+    erodeRectangle(runs, Width, Height, runs);
+    clipRuns(runs, InRegion.getMatSize());
+    OutRegion = Region(std::move(runs), InRegion.getMatSize());
+}
+/// @brief 圆形腐蚀
+/// @param InRegion 输入区域
+/// @param OutRegion 输出区域, 可与输入为同一对象
+/// @param Radius 圆半径, 不小于 0.5
+void pcv::erosionCircle(const Region &InRegion, Region &OutRegion, double Radius)
+{
+    checkRadius(Radius);
+    std::vector<RUN> runs;
+    erodeRuns(InRegion.getRuns(), circleSE(Radius), runs);
+    OutRegion = Region(std::move(runs), InRegion.getMatSize());
+}
+/// @brief 圆形膨胀
+/// @param InRegion 输入区域
+/// @param OutRegion 输出区域, 可与输入为同一对象
+/// @param Radius 圆半径, 不小于 0.5
+void pcv::dilationCircle(const Region &InRegion, Region &OutRegion, double Radius)
+{
+    checkRadius(Radius);
+    std::vector<RUN> runs;
+    dilateRuns(InRegion.getRuns(), circleSE(Radius), runs);
+    clipRuns(runs, InRegion.getMatSize());
+    OutRegion = Region(std::move(runs), InRegion.getMatSize());
+}
+/// @brief 圆形开运算
+/// @param InRegion 输入区域
+/// @param OutRegion 输出区域, 可与输入为同一对象
+/// @param Radius 圆半径, 不小于 0.5
+void pcv::openingCircle(const Region &InRegion, Region &OutRegion, double Radius)
+{
+    checkRadius(Radius);
+    std::vector<SE_ROW> se = circleSE(Radius);
+    std::vector<RUN> runs;
+    erodeRuns(InRegion.getRuns(), se, runs);
+    dilateRuns(runs, se, runs);
+    clipRuns(runs, InRegion.getMatSize());
+    OutRegion = Region(std::move(runs), InRegion.getMatSize());
+}
+/// @brief 圆形闭运算
+/// @param InRegion 输入区域
+/// @param OutRegion 输出区域, 可与输入为同一对象
+/// @param Radius 圆半径, 不小于 0.5
+void pcv::closingCircle(const Region &InRegion, Region &OutRegion, double Radius)
+{
+    checkRadius(Radius);
+    std::vector<SE_ROW> se = circleSE(Radius);
+    std::vector<RUN> runs;
+    dilateRuns(InRegion.getRuns(), se, runs);
+    erodeRuns(runs, se, runs);
+    clipRuns(runs, InRegion.getMatSize());
+    OutRegion = Region(std::move(runs), InRegion.getMatSize());
+}
+/// @brief 填充区域内的孔洞
+/// 在外接矩形内对背景游程做 4 连通标记, 不接触外接矩形边界的背景连通域即为孔洞。
+/// @param InRegion 输入区域
+/// @param OutRegion 输出区域, 可与输入为同一对象
+void pcv::fillUp(const Region &InRegion, Region &OutRegion)
+{
+    const std::vector<RUN> &runs = InRegion.getRuns();
+    if (runs.empty())
+    {
+        OutRegion = Region(std::vector<RUN>(), InRegion.getMatSize());
+        return;
+    }
+
+    int left = runs.front().colStart, right = runs.front().colEnd;
+    for (const RUN &run : runs)
+    {
+        left = std::min(left, run.colStart);
+        right = std::max(right, run.colEnd);
+    }
+    const int top = runs.front().row;
+    const int bottom = runs.back().row;
+
+    // 外接矩形内的背景游程
+    std::vector<RUN> background;
+    size_t k = 0;
+    for (int r = top; r <= bottom; r++)
+    {
+        int c = left;
+        for (; k < runs.size() && runs[k].row == r; k++)
+        {
+            if (runs[k].colStart > c)
+                background.push_back({r, c, runs[k].colStart - 1});
+            c = runs[k].colEnd + 1;
+        }
+        if (c <= right)
+            background.push_back({r, c, right});
+    }
+
+    std::vector<int> labels;
+    int labelNum = pcv::labelRuns(background, labels, 4);
+    std::vector<bool> touchBorder(labelNum, false);
+    for (size_t i = 0; i < background.size(); i++)
+    {
+        const RUN &run = background[i];
+        if (run.row == top || run.row == bottom || run.colStart == left || run.colEnd == right)
+            touchBorder[labels[i]] = true;
+    }
+
+    std::vector<RUN> filled(runs);
+    for (size_t i = 0; i < background.size(); i++)
+    {
+        if (!touchBorder[labels[i]])
+            filled.push_back(background[i]);
+    }
+    normalizeRuns(filled);
+    OutRegion = Region(std::move(filled), InRegion.getMatSize());
+}
+/// @brief 两个区域的并集
+/// @param Region1 区域1
+/// @param Region2 区域2
+/// @param OutRegion 输出区域, 可与输入为同一对象
+void pcv::unionRegion(const Region &Region1, const Region &Region2, Region &OutRegion)
+{
+    checkSameSize(Region1, Region2);
+    std::vector<RUN> runs;
+    unionRuns(Region1.getRuns(), Region2.getRuns(), runs);
+    OutRegion = Region(std::move(runs), Region1.getMatSize());
+}
+/// @brief 集合内所有区域的并集
+/// @param Regions 区域集合
+/// @param OutRegion 输出区域, 集合为空时输出空区域
+void pcv::unionRegion(const RegionSet &Regions, Region &OutRegion)
+{
+    if (Regions.empty())
+    {
+        OutRegion = Region();
+        return;
+    }
+    size_t total = 0;
+    for (const Region &region : Regions)
+    {
+        checkSameSize(Regions[0], region);
+        total += region.getRuns().size();
+    }
+    std::vector<RUN> runs;
+    runs.reserve(total);
+    for (const Region &region : Regions)
+    {
+        runs.insert(runs.end(), region.getRuns().begin(), region.getRuns().end());
+    }
+    normalizeRuns(runs);
+    OutRegion = Region(std::move(runs), Regions[0].getMatSize());
+}
+/// @brief 两个区域的交集
+/// @param Region1 区域1
+/// @param Region2 区域2
+/// @param OutRegion 输出区域, 可与输入为同一对象
+void pcv::intersectionRegion(const Region &Region1, const Region &Region2, Region &OutRegion)
+{
+    checkSameSize(Region1, Region2);
+    std::vector<RUN> runs;
+    intersectRuns(Region1.getRuns(), Region2.getRuns(), runs);
+    OutRegion = Region(std::move(runs), Region1.getMatSize());
+}
+/// @brief 区域与矩形 ROI 的交集
+/// @param InRegion 输入区域
+/// @param Roi 矩形 ROI
+/// @param OutRegion 输出区域, 可与输入为同一对象
+void pcv::intersectionRegion(const Region &InRegion, const cv::Rect &Roi, Region &OutRegion)
+{
+    std::vector<RUN> runs;
+    runs.reserve(InRegion.getRuns().size());
+    for (const RUN &run : InRegion.getRuns())
+    {
+        if (run.row < Roi.y || run.row >= Roi.y + Roi.height)
+            continue;
+        int start = std::max(run.colStart, Roi.x);
+        int end = std::min(run.colEnd, Roi.x + Roi.width - 1);
+        if (start <= end)
+            runs.push_back({run.row, start, end});
+    }
+    OutRegion = Region(std::move(runs), InRegion.getMatSize());
+}
+/// @brief 集合内每个区域与 Other 的交集, 标签保持不变 (结果可能为空区域)
+/// @param InRegions 输入区域集合
+/// @param Other 另一个区域, 例如 ROI
+/// @param OutRegions 输出区域集合, 可与输入为同一对象
+void pcv::intersectionRegion(const RegionSet &InRegions, const Region &Other, RegionSet &OutRegions)
+{
+    RegionSet result;
+    result.reserve(InRegions.size());
+    for (size_t i = 0; i < InRegions.size(); i++)
+    {
+        Region region;
+        pcv::intersectionRegion(InRegions[i], Other, region);
+        result.push(InRegions.getLabel(i), std::move(region));
+    }
+    OutRegions.swap(result);
+}
+/// @brief 两个区域的差集
+/// @param Region1 区域1
+/// @param Region2 区域2
+/// @param OutRegion 输出区域 Region1 - Region2, 可与输入为同一对象
+void pcv::differenceRegion(const Region &Region1, const Region &Region2, Region &OutRegion)
+{
+    checkSameSize(Region1, Region2);
+    std::vector<RUN> runs;
+    subtractRuns(Region1.getRuns(), Region2.getRuns(), runs);
+    OutRegion = Region(std::move(runs), Region1.getMatSize());
+}
+/// @brief 集合内每个区域与 Other 的差集, 标签保持不变 (结果可能为空区域)
+/// @param InRegions 输入区域集合
+/// @param Other 另一个区域, 例如缺陷掩膜
+/// @param OutRegions 输出区域集合, 可与输入为同一对象
+void pcv::differenceRegion(const RegionSet &InRegions, const Region &Other, RegionSet &OutRegions)
+{
+    RegionSet result;
+    result.reserve(InRegions.size());
+    for (size_t i = 0; i < InRegions.size(); i++)
+    {
+        Region region;
+        pcv::differenceRegion(InRegions[i], Other, region);
+        result.push(InRegions.getLabel(i), std::move(region));
+    }
+    OutRegions.swap(result);
+}
+/// @brief 区域在图像范围内的补集
+/// @param InRegion 输入区域
+/// @param OutRegion 输出区域, 可与输入为同一对象
+void pcv::complementRegion(const Region &InRegion, Region &OutRegion)
+{
+    const cv::Size size = InRegion.getMatSize();
+    const std::vector<RUN> &runs = InRegion.getRuns();
+    std::vector<RUN> complement;
+    complement.reserve(runs.size() + size.height);
+    size_t k = 0;
+    for (int r = 0; r < size.height; r++)
+    {
+        int c = 0;
+        for (; k < runs.size() && runs[k].row == r; k++)
+        {
+            if (runs[k].colStart > c)
+                complement.push_back({r, c, runs[k].colStart - 1});
+            c = runs[k].colEnd + 1;
+        }
+        if (c < size.width)
+            complement.push_back({r, c, size.width - 1});
+    }
+    OutRegion = Region(std::move(complement), size);
+}
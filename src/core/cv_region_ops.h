@@ -0,0 +1,31 @@
+#ifndef H_PCV_REGION_OPS
+#define H_PCV_REGION_OPS
+
+#include <vector>
+#include "cv_region.h"
+
+namespace pcv
+{
+    // 游程区域形态学, 计算量与游程数成正比, 不经过整幅图像掩膜
+    // 区域以外 (含图像边界以外) 均视为背景, 结果裁剪到原始图像尺寸内
+    void erosionRectangle(const Region &InRegion, Region &OutRegion, int Width, int Height);  // 矩形腐蚀
+    void dilationRectangle(const Region &InRegion, Region &OutRegion, int Width, int Height); // 矩形膨胀
+    void openingRectangle(const Region &InRegion, Region &OutRegion, int Width, int Height);  // 矩形开运算
+    void closingRectangle(const Region &InRegion, Region &OutRegion, int Width, int Height);  // 矩形闭运算
+    void erosionCircle(const Region &InRegion, Region &OutRegion, double Radius);             // 圆形腐蚀
+    void dilationCircle(const Region &InRegion, Region &OutRegion, double Radius);            // 圆形膨胀
+    void openingCircle(const Region &InRegion, Region &OutRegion, double Radius);             // 圆形开运算
+    void closingCircle(const Region &InRegion, Region &OutRegion, double Radius);             // 圆形闭运算
+    void fillUp(const Region &InRegion, Region &OutRegion);                                   // 填充区域内的孔洞
+
+    // 游程区域集合运算, 两个区域需来自同一尺寸的图像, 结果同样以游程保存
+    void unionRegion(const Region &Region1, const Region &Region2, Region &OutRegion);        // 并集
+    void unionRegion(const RegionSet &Regions, Region &OutRegion);                            // 集合内所有区域的并集
+    void intersectionRegion(const Region &Region1, const Region &Region2, Region &OutRegion); // 交集
+    void intersectionRegion(const Region &InRegion, const cv::Rect &Roi, Region &OutRegion);  // 与矩形 ROI 的交集
+    void intersectionRegion(const RegionSet &InRegions, const Region &Other, RegionSet &OutRegions); // 集合内每个区域与 Other 的交集
+    void differenceRegion(const Region &Region1, const Region &Region2, Region &OutRegion);   // 差集 Region1 - Region2
+    void differenceRegion(const RegionSet &InRegions, const Region &Other, RegionSet &OutRegions);   // 集合内每个区域与 Other 的差集
+    void complementRegion(const Region &InRegion, Region &OutRegion);                         // 在图像范围内的补集
+}; // namespace pcv
+#endif // H_PCV_REGION_OPS
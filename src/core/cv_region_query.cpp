@@ -0,0 +1,204 @@
+#include "cv_region_query.h"
+#include <algorithm>
+
+namespace
+{
+    /// @brief 特征计算代价 (相对值), 用于确定与/或节点中子表达式的求值顺序
+    int featureCost(pcv::SHAPE_FEATURE Feature)
+    {
+        switch (Feature)
+        {
+        case pcv::SHAPE_FEATURE::AREA:
+        case pcv::SHAPE_FEATURE::WIDTH:
+        case pcv::SHAPE_FEATURE::HEIGHT:
+            return 1;
+        case pcv::SHAPE_FEATURE::ROW:
+        case pcv::SHAPE_FEATURE::COLUMN:
+            return 2;
+        case pcv::SHAPE_FEATURE::CIRCULARITY:
+            return 3;
+        case pcv::SHAPE_FEATURE::RECT2_AREA:
+        case pcv::SHAPE_FEATURE::RECTANGULARITY:
+            return 4;
+        default:
+            return 4;
+        }
+    }
+} // namespace
+
+/// @brief 表达式节点: 叶子节点为特征区间, 其余为与/或节点
+struct pcv::ShapeQuery::NODE
+{
+    enum class TYPE
+    {
+        LEAF,
+        AND,
+        OR
+    };
+    TYPE type = TYPE::LEAF;
+    SHAPE_FEATURE feature = SHAPE_FEATURE::AREA;
+    double min = 0.0;
+    double max = 0.0;
+    int cost = 0; // 子树中最昂贵特征的代价
+    std::vector<std::shared_ptr<const NODE>> children;
+
+    bool eval(const Region &InRegion) const
+    {
+        switch (this->type)
+        {
+        case TYPE::LEAF:
+        {
+            double value = calcShapeFeature(InRegion, this->feature);
+            return value >= this->min && value <= this->max;
+        }
+        case TYPE::AND:
+            for (const auto &child : this->children)
+            {
+                if (!child->eval(InRegion))
+                    return false;
+            }
+            return true;
+        case TYPE::OR:
+            for (const auto &child : this->children)
+            {
+                if (child->eval(InRegion))
+                    return true;
+            }
+            return false;
+        default:
+            return false;
+        }
+    }
+};
+
+/// @brief 计算区域的形状特征 (借助 Region 的缓存, 重复计算没有额外开销)
+/// @param InRegion 输入区域
+/// @param Feature 特征类型
+/// @return 特征值
+double pcv::calcShapeFeature(const Region &InRegion, SHAPE_FEATURE Feature)
+{
+    switch (Feature)
+    {
+    case SHAPE_FEATURE::AREA:
+        return InRegion.getRegionArea();
+    case SHAPE_FEATURE::WIDTH:
+        return InRegion.getBoundingRect().width;
+    case SHAPE_FEATURE::HEIGHT:
+        return InRegion.getBoundingRect().height;
+    case SHAPE_FEATURE::ROW:
+        return InRegion.getCentroid().y;
+    case SHAPE_FEATURE::COLUMN:
+        return InRegion.getCentroid().x;
+    case SHAPE_FEATURE::CIRCULARITY:
+        return InRegion.getCircularity();
+    case SHAPE_FEATURE::RECT2_AREA:
+        return InRegion.getMinBoundingRectArea();
+    case SHAPE_FEATURE::RECTANGULARITY:
+    {
+        // 最小外接矩形由像素中心确定, 覆盖的像素面积需各边加 1
+        cv::RotatedRect rect = InRegion.getMinBoundingRect();
+        double coverArea = (rect.size.width + 1.0) * (rect.size.height + 1.0);
+        return std::min(1.0, InRegion.getRegionArea() / coverArea);
+    }
+    default:
+        CV_Error(cv::Error::StsBadArg, "不支持的形状特征。");
+    }
+}
+/// @brief 创建特征区间表达式
+/// @param Feature 特征类型
+/// @param Min 特征下限
+/// @param Max 特征上限
+/// @return 表达式
+pcv::ShapeQuery pcv::ShapeQuery::select(SHAPE_FEATURE Feature, double Min, double Max)
+{
+    auto node = std::make_shared<NODE>();
+    node->type = NODE::TYPE::LEAF;
+    node->feature = Feature;
+    node->min = Min;
+    node->max = Max;
+    node->cost = featureCost(Feature);
+    return ShapeQuery(std::move(node));
+}
+/// @brief 与
+pcv::ShapeQuery pcv::ShapeQuery::operator&&(const ShapeQuery &Other) const
+{
+    return combine(true, *this, Other);
+}
+/// @brief 或
+pcv::ShapeQuery pcv::ShapeQuery::operator||(const ShapeQuery &Other) const
+{
+    return combine(false, *this, Other);
+}
+/// @brief 合并两个表达式, 展开同类节点并按代价排序子表达式
+pcv::ShapeQuery pcv::ShapeQuery::combine(bool IsAnd, const ShapeQuery &Lhs, const ShapeQuery &Rhs)
+{
+    auto node = std::make_shared<NODE>();
+    node->type = IsAnd ? NODE::TYPE::AND : NODE::TYPE::OR;
+    for (const ShapeQuery *query : {&Lhs, &Rhs})
+    {
+        const std::shared_ptr<const NODE> &child = query->m_root;
+        if (child->type == node->type)
+        {
+            node->children.insert(node->children.end(), child->children.begin(), child->children.end());
+        }
+        else
+        {
+            node->children.push_back(child);
+        }
+    }
+    std::stable_sort(node->children.begin(), node->children.end(),
+                     [](const std::shared_ptr<const NODE> &a, const std::shared_ptr<const NODE> &b) { return a->cost < b->cost; });
+    for (const auto &child : node->children)
+    {
+        node->cost = std::max(node->cost, child->cost);
+    }
+    return ShapeQuery(std::move(node));
+}
+/// @brief 判断区域是否满足表达式
+/// @param InRegion 输入区域
+/// @return 是否满足
+bool pcv::ShapeQuery::match(const Region &InRegion) const
+{
+    return this->m_root->eval(InRegion);
+}
+/// @brief 按表达式筛选区域
+/// @param Regions 连通域集合
+/// @param Query 筛选表达式
+/// @param OutIndices 输出满足条件的区域下标
+void pcv::selectShape(const RegionSet &Regions, const ShapeQuery &Query, std::vector<int> &OutIndices)
+{
+    OutIndices.clear();
+    for (size_t i = 0; i < Regions.size(); i++)
+    {
+        if (Query.match(Regions[i]))
+        {
+            OutIndices.push_back(static_cast<int>(i));
+        }
+    }
+}
+/// @brief 在给定下标中按表达式筛选区域 (InIndices 与 OutIndices 可以是同一对象)
+/// @param Regions 连通域集合
+/// @param Query 筛选表达式
+/// @param InIndices 待筛选的区域下标
+/// @param OutIndices 输出满足条件的区域下标
+void pcv::selectShape(const RegionSet &Regions, const ShapeQuery &Query,
+                      const std::vector<int> &InIndices, std::vector<int> &OutIndices)
+{
+    if (&InIndices != &OutIndices)
+    {
+        OutIndices.clear();
+        for (int index : InIndices)
+        {
+            if (Query.match(Regions[index]))
+                OutIndices.push_back(index);
+        }
+        return;
+    }
+    size_t k = 0;
+    for (size_t i = 0; i < OutIndices.size(); i++)
+    {
+        if (Query.match(Regions[OutIndices[i]]))
+            OutIndices[k++] = OutIndices[i];
+    }
+    OutIndices.resize(k);
+}
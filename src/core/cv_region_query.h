@@ -0,0 +1,48 @@
+#ifndef H_PCV_REGION_QUERY
+#define H_PCV_REGION_QUERY
+
+#include <memory>
+#include <vector>
+#include "cv_region.h"
+
+namespace pcv
+{
+    /// @brief 区域形状特征
+    enum class SHAPE_FEATURE
+    {
+        AREA,           // 面积
+        WIDTH,          // 外接矩形宽度
+        HEIGHT,         // 外接矩形高度
+        ROW,            // 质心行坐标
+        COLUMN,         // 质心列坐标
+        CIRCULARITY,    // 圆度
+        RECT2_AREA,     // 最小外接矩形面积
+        RECTANGULARITY  // 矩形度 (面积 / 最小外接矩形覆盖的像素面积)
+    };
+
+    double calcShapeFeature(const Region &InRegion, SHAPE_FEATURE Feature); // 计算单个形状特征
+
+    /// @brief select_shape 风格的区域筛选表达式
+    /// 表达式按需计算特征并短路求值, 与/或节点中代价低的特征先求值,
+    /// 因此被廉价特征否决的区域不会计算最小外接矩形等昂贵特征。
+    class ShapeQuery
+    {
+    public:
+        static ShapeQuery select(SHAPE_FEATURE Feature, double Min, double Max); // 特征位于 [Min, Max]
+        ShapeQuery operator&&(const ShapeQuery &Other) const;                   // 与
+        ShapeQuery operator||(const ShapeQuery &Other) const;                   // 或
+        bool match(const Region &InRegion) const;                               // 区域是否满足表达式
+
+    private:
+        struct NODE;
+        explicit ShapeQuery(std::shared_ptr<const NODE> Root) : m_root(std::move(Root)) {}
+        static ShapeQuery combine(bool IsAnd, const ShapeQuery &Lhs, const ShapeQuery &Rhs);
+
+        std::shared_ptr<const NODE> m_root;
+    };
+
+    void selectShape(const RegionSet &Regions, const ShapeQuery &Query, std::vector<int> &OutIndices); // 按表达式筛选区域
+    void selectShape(const RegionSet &Regions, const ShapeQuery &Query,
+                     const std::vector<int> &InIndices, std::vector<int> &OutIndices);     // 在给定下标中按表达式筛选区域
+}; // namespace pcv
+#endif // H_PCV_REGION_QUERY
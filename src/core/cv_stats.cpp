@@ -0,0 +1,150 @@
+#include "cv_stats.h"
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <vector>
+
+/// @brief 统计直方图并导出各统计量
+/// 各条带并行统计局部直方图后合并; 条带内交替写入 4 个子直方图, 减少相邻相同灰度造成的写后读依赖
+/// @param GrayInMat 输入灰度图像(CV_8UC1)
+void pcv::ImageStats::compute(const cv::Mat &GrayInMat)
+{
+    if (GrayInMat.empty())
+    {
+        CV_Error(cv::Error::StsBadArg, "输入的GrayInMat为空。");
+    }
+    if (GrayInMat.type() != CV_8UC1)
+    {
+        CV_Error(cv::Error::StsBadArg, "输入的GrayInMat不是8位灰度图像。");
+    }
+
+    const int stripeNum = std::min(std::max(1, cv::getNumThreads()) * 4, GrayInMat.rows);
+    std::vector<std::array<int64, 256>> stripeHists(stripeNum);
+    cv::parallel_for_(cv::Range(0, stripeNum), [&](const cv::Range &range) {
+        for (int s = range.start; s < range.end; s++)
+        {
+            int rowBegin = static_cast<int>(static_cast<int64>(GrayInMat.rows) * s / stripeNum);
+            int rowEnd = static_cast<int>(static_cast<int64>(GrayInMat.rows) * (s + 1) / stripeNum);
+            std::vector<int> sub(4 * 256, 0);
+            for (int r = rowBegin; r < rowEnd; r++)
+            {
+                const uchar *row = GrayInMat.ptr<uchar>(r);
+                int c = 0;
+                for (; c <= GrayInMat.cols - 4; c += 4)
+                {
+                    sub[row[c]]++;
+                    sub[256 + row[c + 1]]++;
+                    sub[512 + row[c + 2]]++;
+                    sub[768 + row[c + 3]]++;
+                }
+                for (; c < GrayInMat.cols; c++)
+                    sub[row[c]]++;
+            }
+            for (int i = 0; i < 256; i++)
+                stripeHists[s][i] = static_cast<int64>(sub[i]) + sub[256 + i] + sub[512 + i] + sub[768 + i];
+        }
+    });
+
+    this->m_hist.fill(0);
+    for (const std::array<int64, 256> &hist : stripeHists)
+    {
+        for (int i = 0; i < 256; i++)
+            this->m_hist[i] += hist[i];
+    }
+
+    this->m_pixelNum = static_cast<int64>(GrayInMat.total());
+    this->m_min = 0;
+    while (this->m_min < 255 && this->m_hist[this->m_min] == 0)
+        this->m_min++;
+    this->m_max = 255;
+    while (this->m_max > 0 && this->m_hist[this->m_max] == 0)
+        this->m_max--;
+    double sum = 0.0, sqSum = 0.0;
+    for (int i = 0; i < 256; i++)
+    {
+        sum += static_cast<double>(i) * this->m_hist[i];
+        sqSum += static_cast<double>(i) * i * this->m_hist[i];
+    }
+    this->m_mean = sum / this->m_pixelNum;
+    this->m_variance = std::max(sqSum / this->m_pixelNum - this->m_mean * this->m_mean, 0.0);
+}
+/// @brief 百分位数: 累计像素数达到总数 Percent% 的最小灰度
+/// @param Percent 百分比 [0, 100], 0 为最小灰度, 100 为最大灰度
+int pcv::ImageStats::getPercentile(double Percent) const
+{
+    assert(Percent >= 0 && Percent <= 100 && "Percent must be in the range [0, 100]");
+    double target = std::max(Percent / 100.0 * this->m_pixelNum, 1.0);
+    int64 cumulative = 0;
+    for (int i = 0; i < 256; i++)
+    {
+        cumulative += this->m_hist[i];
+        if (cumulative >= target)
+            return i;
+    }
+    return this->m_max;
+}
+/// @brief Otsu 阈值 (类间方差最大), 与 cv::THRESH_OTSU 相同
+int pcv::ImageStats::getOtsuThreshold() const
+{
+    if (this->m_pixelNum == 0)
+        return 0;
+    const double scale = 1.0 / this->m_pixelNum;
+    double mu = this->m_mean;
+    double mu1 = 0.0, q1 = 0.0;
+    double maxSigma = 0.0;
+    int threshold = 0;
+    for (int i = 0; i < 256; i++)
+    {
+        double p = this->m_hist[i] * scale;
+        mu1 *= q1;
+        q1 += p;
+        double q2 = 1.0 - q1;
+        if (std::min(q1, q2) < FLT_EPSILON || std::max(q1, q2) > 1.0 - FLT_EPSILON)
+            continue;
+        mu1 = (mu1 + i * p) / q1;
+        double mu2 = (mu - q1 * mu1) / q2;
+        double sigma = q1 * q2 * (mu1 - mu2) * (mu1 - mu2);
+        if (sigma > maxSigma)
+        {
+            maxSigma = sigma;
+            threshold = i;
+        }
+    }
+    return threshold;
+}
+/// @brief 三角法阈值 (直方图峰值与较长一侧端点连线的最远点), 与 cv::THRESH_TRIANGLE 相同
+int pcv::ImageStats::getTriangleThreshold() const
+{
+    if (this->m_pixelNum == 0)
+        return 0;
+    std::array<int64, 256> hist = this->m_hist;
+    int leftBound = std::max(this->m_min - 1, 0);
+    int rightBound = std::min(this->m_max + 1, 255);
+    int maxIndex = static_cast<int>(std::max_element(hist.begin(), hist.end()) - hist.begin());
+
+    // 峰值位于右侧时翻转直方图, 总是在峰值左侧搜索
+    bool isFlipped = false;
+    if (maxIndex - leftBound < rightBound - maxIndex)
+    {
+        isFlipped = true;
+        std::reverse(hist.begin(), hist.end());
+        leftBound = 255 - rightBound;
+        maxIndex = 255 - maxIndex;
+    }
+
+    int threshold = leftBound;
+    double a = static_cast<double>(hist[maxIndex]);
+    double b = leftBound - maxIndex;
+    double maxDist = 0.0;
+    for (int i = leftBound + 1; i <= maxIndex; i++)
+    {
+        double dist = a * i + b * hist[i];
+        if (dist > maxDist)
+        {
+            maxDist = dist;
+            threshold = i;
+        }
+    }
+    threshold--;
+    return isFlipped ? 255 - threshold : threshold;
+}
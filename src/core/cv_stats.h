@@ -0,0 +1,39 @@
+#ifndef H_PCV_STATS
+#define H_PCV_STATS
+
+#include <array>
+#include <opencv2/core.hpp>
+
+namespace pcv
+{
+    /// @brief 8 位灰度图像的统计量
+    /// 单次遍历统计直方图, 最值、均值、方差、百分位数和自动阈值均由直方图导出,
+    /// 同一帧的多个处理步骤共享同一个对象即可避免重复遍历图像。
+    class ImageStats
+    {
+    public:
+        ImageStats() = default;
+        explicit ImageStats(const cv::Mat &GrayInMat) { compute(GrayInMat); }
+
+        void compute(const cv::Mat &GrayInMat);                           // 统计直方图并导出各统计量
+        bool empty() const { return this->m_pixelNum == 0; }
+        int64 getPixelNum() const { return this->m_pixelNum; }             // 像素数
+        const std::array<int64, 256> &getHist() const { return this->m_hist; } // 灰度直方图
+        int getMin() const { return this->m_min; }                         // 最小灰度
+        int getMax() const { return this->m_max; }                         // 最大灰度
+        double getMean() const { return this->m_mean; }                    // 均值
+        double getVariance() const { return this->m_variance; }            // 方差
+        int getPercentile(double Percent) const;                           // 百分位数 (Percent 位于 [0, 100])
+        int getOtsuThreshold() const;                                      // Otsu 阈值
+        int getTriangleThreshold() const;                                  // 三角法阈值
+
+    private:
+        std::array<int64, 256> m_hist{};
+        int64 m_pixelNum = 0;
+        int m_min = 0;
+        int m_max = 0;
+        double m_mean = 0.0;
+        double m_variance = 0.0;
+    };
+}; // namespace pcv
+#endif // H_PCV_STATS
@@ -0,0 +1,225 @@
+#include "cv_stream.h"
+#include <chrono>
+
+namespace
+{
+    /// @brief 等待队列时的退避: 先让出时间片, 仍无进展时短暂休眠, 避免空转占满核心
+    inline void backoff(int &Spins)
+    {
+        if (Spins++ < 64)
+            std::this_thread::yield();
+        else
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+} // namespace
+
+pcv::StreamRunner::StreamRunner(int QueueCapacity) : m_capacity(QueueCapacity)
+{
+    if (QueueCapacity <= 0)
+    {
+        CV_Error(cv::Error::StsBadArg, "QueueCapacity必须为正数。");
+    }
+}
+pcv::StreamRunner::~StreamRunner()
+{
+    if (m_running)
+    {
+        stop();
+        for (std::thread &t : m_threads)
+        {
+            if (t.joinable())
+                t.join();
+        }
+    }
+}
+/// @brief 设置数据源
+/// @param Name 阶段名
+/// @param Func 读取下一帧, 返回 false 表示结束; 帧序号由执行器写入
+void pcv::StreamRunner::setSource(const std::string &Name, const SOURCE_FUNC &Func)
+{
+    if (m_running)
+    {
+        CV_Error(cv::Error::StsError, "运行中不能修改数据源。");
+    }
+    m_source.reset(new STAGE());
+    m_source->name = Name;
+    m_source->source = Func;
+}
+/// @brief 追加阶段, 每个阶段独占一个线程
+/// @param Name 阶段名
+/// @param Func 处理一帧, 结果写回帧内
+/// @param Policy 该阶段输入队列满时的策略
+void pcv::StreamRunner::addStage(const std::string &Name, const STAGE_FUNC &Func, DROP_POLICY Policy)
+{
+    if (m_running)
+    {
+        CV_Error(cv::Error::StsError, "运行中不能添加阶段。");
+    }
+    std::unique_ptr<STAGE> stage(new STAGE());
+    stage->name = Name;
+    stage->func = Func;
+    stage->policy = Policy;
+    stage->input.reset(new QUEUE(static_cast<size_t>(m_capacity)));
+    m_stages.push_back(std::move(stage));
+}
+/// @brief 启动数据源及各阶段线程
+void pcv::StreamRunner::start()
+{
+    if (m_running)
+        return;
+    if (!m_source || m_stages.empty())
+    {
+        CV_Error(cv::Error::StsError, "未设置数据源或阶段。");
+    }
+    // 丢弃上一次运行残留的帧
+    STREAM_FRAME frame;
+    for (auto &stage : m_stages)
+    {
+        while (stage->input->tryPop(frame))
+            ;
+        stage->inputClosed = false;
+        stage->frames = 0;
+        stage->dropped = 0;
+        stage->ticks = 0;
+    }
+    m_source->frames = 0;
+    m_source->ticks = 0;
+    m_stop = false;
+    m_failed = false;
+    m_error = nullptr;
+    m_running = true;
+    m_threads.emplace_back(&StreamRunner::sourceLoop, this);
+    for (size_t i = 0; i < m_stages.size(); i++)
+    {
+        m_threads.emplace_back(&StreamRunner::stageLoop, this, i);
+    }
+}
+/// @brief 请求停止, 各线程处理完当前帧后退出
+void pcv::StreamRunner::stop()
+{
+    m_stop = true;
+}
+/// @brief 等待所有线程结束
+void pcv::StreamRunner::wait()
+{
+    for (std::thread &t : m_threads)
+    {
+        if (t.joinable())
+            t.join();
+    }
+    m_threads.clear();
+    m_running = false;
+    if (m_error)
+    {
+        std::exception_ptr error = m_error;
+        m_error = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+/// @brief 获取统计, 运行中也可调用
+std::vector<pcv::StreamRunner::STAGE_STATS> pcv::StreamRunner::getStats() const
+{
+    std::vector<STAGE_STATS> stats;
+    auto collect = [&stats](const STAGE &stage) {
+        stats.push_back({stage.name, stage.frames.load(), stage.dropped.load(),
+                         stage.ticks.load() * 1000.0 / cv::getTickFrequency()});
+    };
+    if (m_source)
+        collect(*m_source);
+    for (const auto &stage : m_stages)
+        collect(*stage);
+    return stats;
+}
+/// @brief 记录第一个异常并停止所有线程
+void pcv::StreamRunner::fail()
+{
+    if (!m_failed.exchange(true))
+        m_error = std::current_exception();
+    m_stop = true;
+}
+/// @brief 把帧放入下一阶段的输入队列
+/// @return 请求停止时返回 false
+bool pcv::StreamRunner::push(STAGE &Next, STREAM_FRAME &&Frame)
+{
+    int spins = 0;
+    STREAM_FRAME oldest;
+    while (!Next.input->tryPush(std::move(Frame)))
+    {
+        if (m_stop)
+            return false;
+        if (Next.policy == DROP_POLICY::DROP_OLDEST && Next.input->tryPop(oldest))
+        {
+            Next.dropped++;
+            continue;
+        }
+        backoff(spins);
+    }
+    return true;
+}
+void pcv::StreamRunner::sourceLoop()
+{
+    STAGE &next = *m_stages.front();
+    try
+    {
+        int64_t index = 0;
+        while (!m_stop)
+        {
+            STREAM_FRAME frame;
+            int64_t begin = cv::getTickCount();
+            bool ok = m_source->source(frame);
+            m_source->ticks += cv::getTickCount() - begin;
+            if (!ok)
+                break;
+            frame.Index = index++;
+            m_source->frames++;
+            if (!push(next, std::move(frame)))
+                break;
+        }
+    }
+    catch (...)
+    {
+        fail();
+    }
+    next.inputClosed.store(true, std::memory_order_release);
+}
+void pcv::StreamRunner::stageLoop(size_t Index)
+{
+    STAGE &stage = *m_stages[Index];
+    STAGE *next = (Index + 1 < m_stages.size()) ? m_stages[Index + 1].get() : nullptr;
+    try
+    {
+        int spins = 0;
+        STREAM_FRAME frame;
+        while (!m_stop)
+        {
+            if (!stage.input->tryPop(frame))
+            {
+                // 上游关闭后再检查一次, 关闭前入队的帧不会遗漏
+                if (stage.inputClosed.load(std::memory_order_acquire))
+                {
+                    if (!stage.input->tryPop(frame))
+                        break;
+                }
+                else
+                {
+                    backoff(spins);
+                    continue;
+                }
+            }
+            spins = 0;
+            int64_t begin = cv::getTickCount();
+            stage.func(frame);
+            stage.ticks += cv::getTickCount() - begin;
+            stage.frames++;
+            if (next != nullptr && !push(*next, std::move(frame)))
+                break;
+            frame = STREAM_FRAME();
+        }
+    }
+    catch (...)
+    {
+        fail();
+    }
+    if (next != nullptr)
+        next->inputClosed.store(true, std::memory_order_release);
+}
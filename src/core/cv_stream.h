@@ -0,0 +1,190 @@
+#ifndef H_PCV_STREAM
+#define H_PCV_STREAM
+
+#include <any>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <opencv2/core.hpp>
+
+namespace pcv
+{
+    /// @brief 有界无锁环形队列
+    /// 每个槽位带序号 (Vyukov 有界队列), 流水线中每条队列只有一个生产线程和一个消费线程;
+    /// DROP_OLDEST 时生产线程也会出队丢弃最旧的元素, 按序号实现的出队在这种情况下依然安全且保持先进先出。
+    template <typename T>
+    class RingQueue
+    {
+    public:
+        /// @param Capacity 容量, 向上取整为 2 的幂
+        explicit RingQueue(size_t Capacity)
+        {
+            size_t size = 1;
+            while (size < Capacity)
+                size <<= 1;
+            m_mask = size - 1;
+            m_cells.reset(new CELL[size]);
+            for (size_t i = 0; i < size; i++)
+                m_cells[i].seq.store(i, std::memory_order_relaxed);
+        }
+        RingQueue(const RingQueue &) = delete;
+        RingQueue &operator=(const RingQueue &) = delete;
+
+        /// @brief 入队, 队列满时返回 false
+        bool tryPush(T &&Value)
+        {
+            size_t pos = m_head.load(std::memory_order_relaxed);
+            CELL *cell;
+            while (true)
+            {
+                cell = &m_cells[pos & m_mask];
+                size_t seq = cell->seq.load(std::memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+                if (diff == 0)
+                {
+                    if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    pos = m_head.load(std::memory_order_relaxed);
+                }
+            }
+            cell->value = std::move(Value);
+            cell->seq.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+        /// @brief 出队, 队列空时返回 false
+        bool tryPop(T &Value)
+        {
+            size_t pos = m_tail.load(std::memory_order_relaxed);
+            CELL *cell;
+            while (true)
+            {
+                cell = &m_cells[pos & m_mask];
+                size_t seq = cell->seq.load(std::memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+                if (diff == 0)
+                {
+                    if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    pos = m_tail.load(std::memory_order_relaxed);
+                }
+            }
+            Value = std::move(cell->value);
+            cell->value = T();
+            cell->seq.store(pos + m_mask + 1, std::memory_order_release);
+            return true;
+        }
+        size_t capacity() const { return m_mask + 1; }
+
+    private:
+        struct CELL
+        {
+            std::atomic<size_t> seq;
+            T value;
+        };
+
+        std::unique_ptr<CELL[]> m_cells;
+        size_t m_mask = 0;
+        alignas(64) std::atomic<size_t> m_head{0}; // 入队位置
+        alignas(64) std::atomic<size_t> m_tail{0}; // 出队位置
+    };
+
+    /// @brief 流水线中传递的一帧
+    struct STREAM_FRAME
+    {
+        int64_t Index = -1; // 帧序号, 由数据源阶段写入
+        cv::Mat Image;      // 原始图像
+        cv::Mat Processed;  // 预处理结果 (letterbox 等)
+        std::any Data;      // 阶段间传递的其他结果 (检测结果等)
+    };
+
+    /// @brief 队列满时的策略
+    enum class DROP_POLICY
+    {
+        BLOCK,      // 阻塞上游, 不丢帧
+        DROP_OLDEST // 丢弃队列中最旧的帧, 上游不阻塞
+    };
+
+    /// @brief 多级流式执行器
+    /// 数据源和每个阶段各占一个线程, 相邻阶段之间为有界无锁队列, 不同帧在各阶段重叠执行,
+    /// 稳态吞吐量取决于最慢的阶段而非各阶段耗时之和。每个阶段按帧序号顺序处理。
+    /// 例: setSource(读取摄像头) -> addStage(letterbox) -> addStage(FaceDetectorDNN::detect) -> addStage(visualize)
+    class StreamRunner
+    {
+    public:
+        using SOURCE_FUNC = std::function<bool(STREAM_FRAME &Frame)>; // 读取下一帧, 返回 false 表示结束
+        using STAGE_FUNC = std::function<void(STREAM_FRAME &Frame)>;
+
+        /// @brief 阶段统计
+        struct STAGE_STATS
+        {
+            std::string Name;
+            int64_t Frames;      // 已处理帧数
+            int64_t Dropped;     // 输入队列中被丢弃的帧数
+            double Milliseconds; // 累计处理耗时
+        };
+
+        explicit StreamRunner(int QueueCapacity = 4);
+        ~StreamRunner();
+        StreamRunner(const StreamRunner &) = delete;
+        StreamRunner &operator=(const StreamRunner &) = delete;
+
+        void setSource(const std::string &Name, const SOURCE_FUNC &Func);                               // 设置数据源
+        void addStage(const std::string &Name, const STAGE_FUNC &Func, DROP_POLICY Policy = DROP_POLICY::BLOCK); // 追加阶段, Policy 作用于该阶段的输入队列
+
+        void start();                           // 启动所有线程
+        void stop();                            // 请求停止, 未处理完的帧被丢弃
+        void wait();                            // 等待结束, 重新抛出阶段中的异常
+        void run() { start(); wait(); }         // 处理到数据源结束
+        bool isRunning() const { return m_running; }
+        std::vector<STAGE_STATS> getStats() const; // 数据源在前, 各阶段按添加顺序
+
+    private:
+        using QUEUE = RingQueue<STREAM_FRAME>;
+        struct STAGE
+        {
+            std::string name;
+            STAGE_FUNC func;
+            SOURCE_FUNC source;
+            DROP_POLICY policy = DROP_POLICY::BLOCK;
+            std::unique_ptr<QUEUE> input;  // 数据源没有输入队列
+            std::atomic<bool> inputClosed{false};
+            std::atomic<int64_t> frames{0};
+            std::atomic<int64_t> dropped{0};
+            std::atomic<int64_t> ticks{0};
+        };
+
+        void sourceLoop();
+        void stageLoop(size_t Index);
+        bool push(STAGE &Next, STREAM_FRAME &&Frame);
+        void fail();
+
+        int m_capacity;
+        std::unique_ptr<STAGE> m_source;
+        std::vector<std::unique_ptr<STAGE>> m_stages;
+        std::vector<std::thread> m_threads;
+        std::atomic<bool> m_stop{false};
+        bool m_running = false;
+        std::exception_ptr m_error;
+        std::atomic<bool> m_failed{false};
+    };
+}; // namespace pcv
+#endif // H_PCV_STREAM
@@ -0,0 +1,76 @@
+#include "cv_tile.h"
+#include <algorithm>
+
+pcv::TileExecutor::TileExecutor(const cv::Size &TileSize)
+{
+    setTileSize(TileSize);
+}
+/// @brief 设置块大小; 宽度取整行时各块在内存中连续, 适合按行访问的算子
+void pcv::TileExecutor::setTileSize(const cv::Size &TileSize)
+{
+    if (TileSize.width <= 0 || TileSize.height <= 0)
+    {
+        CV_Error(cv::Error::StsBadArg, "TileSize必须为正数。");
+    }
+    this->m_tileSize = TileSize;
+}
+/// @brief 按行优先顺序划分块, 右侧和下方的块可能较小
+/// @param ImageSize 图像尺寸
+/// @param OutTiles 输出块 (不含 Halo)
+void pcv::TileExecutor::getTiles(const cv::Size &ImageSize, std::vector<cv::Rect> &OutTiles) const
+{
+    OutTiles.clear();
+    for (int y = 0; y < ImageSize.height; y += this->m_tileSize.height)
+    {
+        for (int x = 0; x < ImageSize.width; x += this->m_tileSize.width)
+        {
+            OutTiles.emplace_back(x, y, std::min(this->m_tileSize.width, ImageSize.width - x),
+                                  std::min(this->m_tileSize.height, ImageSize.height - y));
+        }
+    }
+}
+/// @brief 分块并行执行算子, 各块写入同一个输出图像
+/// 扩展后的输入块裁剪到图像范围内, 因此图像边界处的处理与整幅图像相同; 块内部 OpenCV 的并行会退化为串行执行
+/// @param InMat 输入图像
+/// @param OutMat 输出图像, 尺寸与 InMat 相同; 可与 InMat 相同
+/// @param OutType 输出类型
+/// @param Halo 算子的邻域半径
+/// @param Func 块算子
+void pcv::TileExecutor::run(const cv::Mat &InMat, cv::Mat &OutMat, int OutType, int Halo, const TILE_FUNC &Func) const
+{
+    if (InMat.empty() || Halo < 0)
+    {
+        CV_Error(cv::Error::StsBadArg, "输入图像为空或Halo为负数。");
+    }
+    // 原地处理且有 Halo 时, 相邻块会读到已写回的结果
+    cv::Mat src = (OutMat.data == InMat.data && Halo > 0) ? InMat.clone() : InMat;
+    OutMat.create(src.size(), OutType);
+
+    std::vector<cv::Rect> tiles;
+    getTiles(src.size(), tiles);
+    const cv::Rect imageRect(0, 0, src.cols, src.rows);
+    cv::parallel_for_(cv::Range(0, static_cast<int>(tiles.size())), [&](const cv::Range &range) {
+        cv::Mat buffer; // 有 Halo 时的块输出, 同一线程内复用
+        for (int t = range.start; t < range.end; t++)
+        {
+            const cv::Rect &tile = tiles[t];
+            cv::Rect expanded = cv::Rect(tile.x - Halo, tile.y - Halo, tile.width + 2 * Halo, tile.height + 2 * Halo) & imageRect;
+            cv::Mat dst = OutMat(tile);
+            if (Halo == 0)
+            {
+                // 无 Halo 时直接写入输出图像的对应区域
+                cv::Mat outTile = dst;
+                Func(src(tile), outTile);
+                if (outTile.data != dst.data)
+                    outTile.copyTo(dst);
+                continue;
+            }
+            Func(src(expanded), buffer);
+            if (buffer.size() != expanded.size() || buffer.type() != OutType)
+            {
+                CV_Error(cv::Error::StsUnmatchedSizes, "块算子的输出尺寸或类型与输入块不一致。");
+            }
+            buffer(cv::Rect(tile.tl() - expanded.tl(), tile.size())).copyTo(dst);
+        }
+    }, static_cast<double>(tiles.size()));
+}
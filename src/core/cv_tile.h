@@ -0,0 +1,31 @@
+#ifndef H_PCV_TILE
+#define H_PCV_TILE
+
+#include <functional>
+#include <vector>
+#include <opencv2/core.hpp>
+
+namespace pcv
+{
+    /// @brief 分块并行执行器
+    /// 把图像划分为缓存大小的块, 每块按算子的邻域半径 (Halo) 向外扩展后交给算子处理, 只把块内部写回输出,
+    /// 因此邻域半径不超过 Halo 的算子结果与整幅图像处理完全一致, 没有拼接缝。
+    /// 常用的 Halo: 点运算为 0, calcLBP 为 1, CircularLBP 为 getBorder, 卷积核为 kernel / 2。
+    class TileExecutor
+    {
+    public:
+        /// @brief 块算子: InTile 为扩展后的输入块, OutTile 需输出与 InTile 同尺寸的结果
+        using TILE_FUNC = std::function<void(const cv::Mat &InTile, cv::Mat &OutTile)>;
+
+        explicit TileExecutor(const cv::Size &TileSize = cv::Size(512, 64));
+
+        void setTileSize(const cv::Size &TileSize);                                 // 设置块大小
+        cv::Size getTileSize() const { return this->m_tileSize; }
+        void getTiles(const cv::Size &ImageSize, std::vector<cv::Rect> &OutTiles) const; // 划分块 (不含 Halo)
+        void run(const cv::Mat &InMat, cv::Mat &OutMat, int OutType, int Halo, const TILE_FUNC &Func) const; // 分块并行执行算子
+
+    private:
+        cv::Size m_tileSize;
+    };
+}; // namespace pcv
+#endif // H_PCV_TILE
@@ -1,27 +1,36 @@
 #include "cv_glcm.h"
 #include "core/cv_core.h"
+#include <algorithm>
 #include <Eigen/Dense>
 #include <opencv2/opencv.hpp>
 
 namespace pcv::GLCM
 {
     void calcGlcmMat(cv::Mat &GrayInMat, cv::Mat &GlcmMat, GLCM_TYPE GlcmType, GRAY_LEVEL GrayLevel)
+    {
+        assert(!GrayInMat.empty() && "Input gray image is empty");
+        calcGlcmMat(GrayInMat, GlcmMat, ImageStats(GrayInMat), GlcmType, GrayLevel);
+    }
+    /// @brief Calculate GLCM using precomputed statistics, so the frame is not scanned again for its maximum
+    /// @param GrayInMat 8-bit gray image, quantized in place when its maximum exceeds the gray level
+    /// @param GlcmMat
+    /// @param Stats statistics of GrayInMat
+    /// @param GlcmType
+    /// @param GrayLevel
+    void calcGlcmMat(cv::Mat &GrayInMat, cv::Mat &GlcmMat, const ImageStats &Stats, GLCM_TYPE GlcmType, GRAY_LEVEL GrayLevel)
     {
         // Step 1: Verify input type
         assert(!GrayInMat.empty() && "Input gray image is empty");
+        assert(Stats.getPixelNum() == static_cast<int64>(GrayInMat.total()) && "Stats must be computed from the input image");
 
         // Step 2: Resize gray levels
-        double minVal, maxVal;
-        cv::minMaxLoc(GrayInMat, &minVal, &maxVal);
+        const int maxVal = Stats.getMax();
         if (maxVal >= (int)GrayLevel)
         {
-            zoomGray(GrayInMat, (int)GrayLevel, false); // Scale to [0, GrayLevel) range
+            quantizeGray(GrayInMat, GrayInMat, (int)GrayLevel, false, maxVal); // Scale to [0, GrayLevel) range
         }
 
-        // Step 3: Initialize GLCM matrix
-        GlcmMat = cv::Mat::zeros((int)GrayLevel, (int)GrayLevel, CV_32F);
-
-        // Step 4: Calculate GLCM based on the direction
+        // Step 3: Calculate GLCM based on the direction
         int dx = 0, dy = 0;
         switch (GlcmType)
         {
@@ -45,21 +54,53 @@ namespace pcv::GLCM
             break;
         }
 
-        // Step 5: Traverse the image and update GLCM
-        for (int i = 0; i < GrayInMat.rows; ++i)
-        {
-            for (int j = 0; j < GrayInMat.cols; ++j)
+        // Step 4: Traverse the image and update GLCM
+        const int rowBegin = std::max(0, -dy), rowEnd = std::min(GrayInMat.rows, GrayInMat.rows - dy);
+        const int colBegin = std::max(0, -dx), colEnd = std::min(GrayInMat.cols, GrayInMat.cols - dx);
+        const int levels = (int)GrayLevel;
+        auto countRows = [&](int begin, int end, int *hist) {
+            for (int i = begin; i < end; ++i)
             {
-                if (i + dy >= 0 && i + dy < GrayInMat.rows && j + dx >= 0 && j + dx < GrayInMat.cols)
+                const uchar *cur = GrayInMat.ptr<uchar>(i);
+                const uchar *next = GrayInMat.ptr<uchar>(i + dy) + dx;
+                for (int j = colBegin; j < colEnd; ++j)
+                {
+                    hist[cur[j] * levels + next[j]]++;
+                }
+            }
+        };
+
+        // Each stripe counts into its own levels x levels matrix that must be zeroed and merged,
+        // so a stripe needs enough pixels to amortise that; small inputs (e.g. per-region GLCM) count serially
+        const int64 pixelNum = static_cast<int64>(std::max(0, rowEnd - rowBegin)) * std::max(0, colEnd - colBegin);
+        const int64 minStripePixels = static_cast<int64>(levels) * levels * 16;
+        const int stripeNum = static_cast<int>(std::max<int64>(1, std::min<int64>({static_cast<int64>(cv::getNumThreads()) * 4,
+                                                                                   static_cast<int64>(rowEnd - rowBegin),
+                                                                                   pixelNum / minStripePixels})));
+        cv::Mat total = cv::Mat::zeros(levels, levels, CV_32SC1);
+        if (stripeNum == 1)
+        {
+            countRows(rowBegin, rowEnd, total.ptr<int>());
+        }
+        else
+        {
+            std::vector<cv::Mat> counts(stripeNum);
+            cv::parallel_for_(cv::Range(0, stripeNum), [&](const cv::Range &range) {
+                for (int s = range.start; s < range.end; s++)
                 {
-                    int row = GrayInMat.at<uchar>(i, j);
-                    int col = GrayInMat.at<uchar>(i + dy, j + dx);
-                    GlcmMat.at<float>(row, col)++;
+                    counts[s] = cv::Mat::zeros(levels, levels, CV_32SC1);
+                    countRows(rowBegin + (rowEnd - rowBegin) * s / stripeNum,
+                              rowBegin + (rowEnd - rowBegin) * (s + 1) / stripeNum, counts[s].ptr<int>());
                 }
+            });
+            for (const cv::Mat &count : counts)
+            {
+                total += count;
             }
         }
+        total.convertTo(GlcmMat, CV_32F);
 
-        // Step 6: Normalize GLCM by dividing by total count
+        // Step 5: Normalize GLCM by dividing by total count
         GlcmMat /= cv::sum(GlcmMat)[0];
     }
     /// @brief Calculate GLCM data
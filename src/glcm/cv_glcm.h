@@ -7,6 +7,8 @@
 
 namespace pcv
 {
+    class ImageStats;
+
     namespace GLCM
     {
         enum class GLCM_TYPE
@@ -64,6 +66,7 @@ namespace pcv
         };
 
         void calcGlcmMat(cv::Mat &GrayInMat, cv::Mat &GlcmMat, GLCM_TYPE GlcmType, GRAY_LEVEL GrayLevel = GRAY_LEVEL::GL_64);
+        void calcGlcmMat(cv::Mat &GrayInMat, cv::Mat &GlcmMat, const ImageStats &Stats, GLCM_TYPE GlcmType, GRAY_LEVEL GrayLevel = GRAY_LEVEL::GL_64);
         void calcGlcmData(const cv::Mat &GlcmMat, GLCMDATA &GlcmData);
 
         float calcContrast(const cv::Mat &GlcmMat);
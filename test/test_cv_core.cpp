@@ -1,5 +1,25 @@
 #include <gtest/gtest.h>
 #include "core/cv_core.h"
+#include "core/cv_lbp.h"
+#include "core/cv_point_ops.h"
+#include "core/cv_enhance.h"
+#include "core/cv_gabor.h"
+#include "core/cv_blob.h"
+#include "core/cv_buffer_pool.h"
+#include "core/cv_tile.h"
+#include "core/cv_pipeline.h"
+#include "core/cv_region.h"
+#include "core/cv_stream.h"
+#include "core/cv_image_source.h"
+#include "core/cv_raw_frame.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include <iostream>
 
 namespace pcv
 {
@@ -45,6 +65,70 @@ TEST(CvCoreTest, Letterbox)
     cv::imwrite("Letterbox.jpg", padded_image);
 }
 
+TEST(CvCoreTest, LetterboxBlob)
+{
+    cv::Mat image = cv::imread("test.jpg");
+    ASSERT_FALSE(image.empty());
+
+    BLOB_PARAM param;
+    param.TargetSize = cv::Size(320, 256);
+    param.Mean = cv::Scalar(120, 110, 100);
+    param.Scale = cv::Scalar(1 / 58.0, 1 / 57.0, 1 / 57.5);
+
+    // 参考流程: letterbox -> BGR 转 RGB -> 归一化 -> HWC 转 CHW
+    cv::Mat padded_image, rgb;
+    BOX_RECT pads;
+    letterbox(image, padded_image, pads, param.TargetSize, param.PadColor);
+    cv::cvtColor(padded_image, rgb, cv::COLOR_BGR2RGB);
+    std::vector<cv::Mat> planes;
+    cv::split(rgb, planes);
+
+    cv::Mat blob;
+    BOX_RECT blob_pads;
+    letterboxBlob(image, blob, blob_pads, param);
+    ASSERT_EQ(blob.dims, 4);
+    EXPECT_EQ(blob.size[0], 1);
+    EXPECT_EQ(blob.size[1], 3);
+    EXPECT_EQ(blob.size[2], 256);
+    EXPECT_EQ(blob.size[3], 320);
+    EXPECT_EQ(blob_pads.left, pads.left);
+    EXPECT_EQ(blob_pads.top, pads.top);
+    EXPECT_EQ(blob_pads.right, pads.right);
+    EXPECT_EQ(blob_pads.bottom, pads.bottom);
+    for (int k = 0; k < 3; k++)
+    {
+        cv::Mat expected;
+        planes[k].convertTo(expected, CV_32F, param.Scale[k], -param.Mean[k] * param.Scale[k]);
+        cv::Mat plane(256, 320, CV_32F, blob.ptr<float>() + k * 256 * 320);
+        // 双线性插值与 cv::resize 的定点实现最多相差 1 个灰度级
+        EXPECT_LE(cv::norm(plane, expected, cv::NORM_INF), 1.01 * param.Scale[k]) << k;
+    }
+
+    // 批量写入同一张量, 复用已分配的内存
+    std::vector<BOX_RECT> batch_pads;
+    cv::Mat flipped;
+    cv::flip(image, flipped, 1);
+    letterboxBlob({image, flipped}, blob, batch_pads, param);
+    EXPECT_EQ(blob.size[0], 2);
+    ASSERT_EQ(batch_pads.size(), 2u);
+    const uchar *data = blob.data;
+    letterboxBlob({image, flipped}, blob, batch_pads, param);
+    EXPECT_EQ(blob.data, data);
+    cv::Mat first(3 * 256 * 320, 1, CV_32F, blob.ptr<float>());
+    cv::Mat single;
+    letterboxBlob(image, single, blob_pads, param);
+    EXPECT_EQ(cv::norm(first, cv::Mat(3 * 256 * 320, 1, CV_32F, single.ptr<float>()), cv::NORM_INF), 0.0);
+
+    // int8 输出
+    param.Depth = CV_8S;
+    param.Mean = cv::Scalar::all(128);
+    param.Scale = cv::Scalar::all(1.0);
+    cv::Mat int8_blob;
+    letterboxBlob(image, int8_blob, blob_pads, param);
+    EXPECT_EQ(int8_blob.type(), CV_8S);
+    EXPECT_EQ(int8_blob.ptr<schar>()[0], 0); // 左上角为填充 (128 - 128)
+}
+
 TEST(CvCoreTest, Threshold)
 {
     cv::Mat image = cv::imread("test.jpg");
@@ -110,6 +194,113 @@ TEST(CvCoreTest, ZoomGray)
     cv::imwrite("ZoomGray.jpg", zoomed_image);
 }
 
+TEST(CvCoreTest, QuantizeGray)
+{
+    cv::Mat image(40, 50, CV_8UC1);
+    cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(200));
+
+    // 与逐像素浮点实现对比
+    double max_val;
+    cv::minMaxLoc(image, nullptr, &max_val);
+    float scale = 15.0f / static_cast<float>(max_val);
+    cv::Mat quantized;
+    quantizeGray(image, quantized, 16, false);
+    ASSERT_EQ(quantized.type(), CV_8UC1);
+    for (int i = 0; i < image.rows; i++)
+    {
+        for (int j = 0; j < image.cols; j++)
+        {
+            uchar expected = cv::saturate_cast<uchar>(std::min(image.at<uchar>(i, j) * scale, 15.0f));
+            ASSERT_EQ(quantized.at<uchar>(i, j), expected);
+        }
+    }
+
+    // 16 位输入量化为 8 位灰度级
+    cv::Mat image16;
+    image.convertTo(image16, CV_16U, 300);
+    cv::Mat quantized16;
+    quantizeGray(image16, quantized16, 16, false);
+    ASSERT_EQ(quantized16.type(), CV_8UC1);
+    EXPECT_LE(cv::norm(quantized16, quantized, cv::NORM_INF), 1.0); // 缩放比例不同, 仅 .5 处舍入可能不同
+
+    cv::Mat closed = image.clone();
+    zoomGray(closed, 64, true);
+    cv::minMaxLoc(closed, nullptr, &max_val);
+    EXPECT_EQ(max_val, 64);
+
+    // MaxGray 低于实际最大灰度时, 8 位与 16 位都饱和到最高灰度级
+    cv::Mat ramp(1, 200, CV_8UC1), ramp16, clipped, clipped16;
+    for (int i = 0; i < ramp.cols; i++)
+        ramp.at<uchar>(i) = static_cast<uchar>(i);
+    ramp.convertTo(ramp16, CV_16U);
+    quantizeGray(ramp, clipped, 16, false, 100);
+    quantizeGray(ramp16, clipped16, 16, false, 100);
+    EXPECT_EQ(cv::norm(clipped, clipped16, cv::NORM_INF), 0.0);
+    EXPECT_EQ(clipped.at<uchar>(199), clipped.at<uchar>(100));
+    EXPECT_EQ(clipped.at<uchar>(199), 15);
+}
+
+TEST(CvCoreTest, ImageStats)
+{
+    cv::Mat image = cv::imread("test.jpg");
+    ASSERT_FALSE(image.empty());
+    cv::cvtColor(image, image, cv::COLOR_BGR2GRAY);
+
+    ImageStats stats(image);
+    double min_val, max_val;
+    cv::minMaxLoc(image, &min_val, &max_val);
+    cv::Scalar mean, stddev;
+    cv::meanStdDev(image, mean, stddev);
+    EXPECT_EQ(stats.getPixelNum(), static_cast<int64>(image.total()));
+    EXPECT_EQ(stats.getMin(), min_val);
+    EXPECT_EQ(stats.getMax(), max_val);
+    EXPECT_NEAR(stats.getMean(), mean[0], 1e-6);
+    EXPECT_NEAR(stats.getVariance(), stddev[0] * stddev[0], 1e-3);
+    EXPECT_EQ(stats.getPercentile(0), stats.getMin());
+    EXPECT_EQ(stats.getPercentile(100), stats.getMax());
+    // 百分位数与排序后的像素一致: 第 ceil(P% * N) 个像素
+    auto sortedPercentile = [](const cv::Mat &GrayInMat, double Percent) {
+        std::vector<uchar> pixels(GrayInMat.begin<uchar>(), GrayInMat.end<uchar>());
+        std::sort(pixels.begin(), pixels.end());
+        size_t rank = std::max<size_t>(1, static_cast<size_t>(std::ceil(Percent / 100.0 * pixels.size())));
+        return static_cast<int>(pixels[rank - 1]);
+    };
+    for (double percent : {1.0, 25.0, 50.0, 99.0})
+    {
+        EXPECT_EQ(stats.getPercentile(percent), sortedPercentile(image, percent)) << percent;
+    }
+
+    // 自动阈值与 OpenCV 一致
+    cv::Mat expected, thresholded_image;
+    double otsu = cv::threshold(image, expected, 0, 255, cv::THRESH_BINARY | cv::THRESH_OTSU);
+    EXPECT_EQ(autoThreshold(image, thresholded_image, stats, AUTO_THRESHOLD::OTSU), otsu);
+    EXPECT_EQ(cv::countNonZero(thresholded_image != expected), 0);
+    double triangle = cv::threshold(image, expected, 0, 255, cv::THRESH_BINARY | cv::THRESH_TRIANGLE);
+    EXPECT_EQ(autoThreshold(image, thresholded_image, stats, AUTO_THRESHOLD::TRIANGLE), triangle);
+    EXPECT_EQ(cv::countNonZero(thresholded_image != expected), 0);
+
+    // 共享统计量的结果与各自统计的结果一致
+    cv::Mat gamma1, gamma2;
+    autoGammaImage(image, gamma1, 0.5f);
+    autoGammaImage(image, gamma2, 0.5f, stats);
+    EXPECT_EQ(cv::countNonZero(gamma1 != gamma2), 0);
+    cv::Mat zoom1 = image.clone(), zoom2 = image.clone();
+    zoomGray(zoom1, 32);
+    zoomGray(zoom2, stats, 32);
+    EXPECT_EQ(cv::countNonZero(zoom1 != zoom2), 0);
+
+    cv::Mat scaled_image;
+    scaleImage(image, scaled_image, stats, 1, 99);
+    ImageStats scaled(scaled_image);
+    // 低于 1% 分位的像素映射为 0, 高于 99% 分位的像素映射为 255
+    EXPECT_EQ(scaled.getPercentile(1), 0);
+    EXPECT_EQ(scaled.getPercentile(1), sortedPercentile(scaled_image, 1));
+    EXPECT_EQ(scaled.getPercentile(99), 255);
+
+    ImageStats emptyStats;
+    EXPECT_THROW(emptyStats.compute(cv::Mat()), cv::Exception);
+}
+
 TEST(CvCoreTest, GammaImage)
 {
     cv::Mat image = cv::imread("test.jpg");
@@ -136,6 +327,37 @@ TEST(CvCoreTest, AutoGammaImage)
     cv::imwrite("AutoGammaImage.jpg", auto_gamma_image);
 }
 
+TEST(CvCoreTest, AutoGammaStream)
+{
+    cv::Mat dark(60, 80, CV_8UC1, cv::Scalar::all(60));
+    cv::Mat bright(60, 80, CV_8UC1, cv::Scalar::all(180));
+
+    AutoGammaStream stream(0.5f, 0.5f, 4, 0.001f);
+    cv::Mat output;
+    stream.apply(dark, output);
+    float gamma_dark = static_cast<float>(log10(1 - 0.5) / log10(1 - 60 / 255.0));
+    EXPECT_NEAR(stream.getGamma(), gamma_dark, 1e-5);
+
+    // 第一帧与 autoGammaImage 仅相差伽马量化误差
+    cv::Mat expected;
+    autoGammaImage(dark, expected, 0.5f);
+    EXPECT_LE(cv::norm(output, expected, cv::NORM_INF), 1.0);
+
+    // 均值不变时查找表不重建
+    cv::Mat lut = stream.getLut().clone();
+    stream.apply(dark, output);
+    EXPECT_EQ(cv::countNonZero(lut != stream.getLut()), 0);
+
+    // 指数平滑
+    stream.apply(bright, output);
+    float gamma_bright = static_cast<float>(log10(1 - 0.5) / log10(1 - 180 / 255.0));
+    EXPECT_NEAR(stream.getGamma(), 0.5f * gamma_dark + 0.5f * gamma_bright, 1e-4);
+
+    stream.reset();
+    stream.apply(bright, output, ImageStats(bright));
+    EXPECT_NEAR(stream.getGamma(), gamma_bright, 1e-5);
+}
+
 TEST(CvCoreTest, LinearGrayLevelTrans)
 {
     cv::Mat image = cv::imread("test.jpg");
@@ -164,6 +386,72 @@ TEST(CvCoreTest, LinearLevelTrans)
     cv::imwrite("LinearLevelTrans.jpg", transformed_image);
 }
 
+TEST(CvCoreTest, LinearLevelLut)
+{
+    int Th1 = 50, Th2 = 200, Goal1 = 30, Goal2 = 220;
+    cv::Mat lut;
+    linearLevelLut(Th1, Th2, Goal1, Goal2, lut);
+    ASSERT_EQ(lut.size(), cv::Size(256, 1));
+
+    // 与逐像素浮点实现对比
+    for (int i = 0; i < 256; i++)
+    {
+        float pixel = static_cast<float>(i);
+        if (pixel <= Th1)
+            pixel = pixel * Goal1 / Th1;
+        else if (pixel <= Th2)
+            pixel = (pixel - Th1) * (Goal2 - Goal1) / (Th2 - Th1) + Goal1;
+        else
+            pixel = (pixel - Th2) * (255 - Goal2) / (255 - Th2) + Goal2;
+        EXPECT_EQ(lut.at<uchar>(i), cv::saturate_cast<uchar>(pixel)) << i;
+    }
+
+    // 任意通道数
+    cv::Mat image(8, 8, CV_8UC4);
+    cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(256));
+    cv::Mat transformed_image;
+    linearLevelTrans(image, transformed_image, Th1, Th2, Goal1, Goal2);
+    ASSERT_EQ(transformed_image.type(), CV_8UC4);
+    EXPECT_EQ(transformed_image.at<cv::Vec4b>(3, 5)[2], lut.at<uchar>(image.at<cv::Vec4b>(3, 5)[2]));
+}
+
+TEST(CvCoreTest, PointOpChain)
+{
+    cv::Mat image(64, 80, CV_8UC1);
+    cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(256));
+
+    // 依次调用
+    cv::Mat expected;
+    scaleImage(image, expected, 20, 230);
+    gammaImage(expected, expected, 0.8f);
+    logImage(expected, expected, 45.0f);
+    invertImage(expected, expected);
+    threshold(expected, expected, 40, 200);
+
+    PointOpChain chain;
+    chain.scale(20, 230).gamma(0.8f).log(45.0f).invert().threshold(40, 200);
+    cv::Mat output(image.size(), CV_8UC1);
+    const uchar *buffer = output.data;
+    chain.apply(image, output);
+    EXPECT_EQ(output.data, buffer);
+    EXPECT_EQ(cv::countNonZero(output != expected), 0);
+
+    // 逐通道查找表
+    cv::Mat color(16, 16, CV_8UC3);
+    cv::randu(color, cv::Scalar::all(0), cv::Scalar::all(256));
+    cv::Mat channelLut(1, 256, CV_8UC3);
+    for (int i = 0; i < 256; i++)
+        channelLut.at<cv::Vec3b>(i) = cv::Vec3b(static_cast<uchar>(i), static_cast<uchar>(255 - i), static_cast<uchar>(i / 2));
+    chain.reset();
+    chain.invert().lut(channelLut);
+    chain.apply(color, output);
+    cv::Vec3b in = color.at<cv::Vec3b>(7, 9), out = output.at<cv::Vec3b>(7, 9);
+    EXPECT_EQ(out[0], 255 - in[0]);
+    EXPECT_EQ(out[1], in[1]);
+    EXPECT_EQ(out[2], (255 - in[2]) / 2);
+    EXPECT_THROW(chain.apply(image, output), cv::Exception);
+}
+
 TEST(CvCoreTest, LogImage)
 {
     cv::Mat image = cv::imread("test.jpg");
@@ -192,6 +480,126 @@ TEST(CvCoreTest, EqualizeColor)
     cv::imwrite("EqualizeColor.jpg", equalized_image);
 }
 
+TEST(CvCoreTest, ColorEqualizer)
+{
+    cv::Mat image = cv::imread("test.jpg");
+    ASSERT_FALSE(image.empty());
+
+    ColorEqualizer equalizer(2.0);
+    cv::Mat equalized_image;
+    equalizer.apply(image, equalized_image);
+    ASSERT_EQ(equalized_image.type(), CV_8UC3);
+
+    // 定点 L 通道与 OpenCV 的 Lab 转换一致
+    cv::Mat lab;
+    std::vector<cv::Mat> channels;
+    cv::cvtColor(image, lab, cv::COLOR_BGR2Lab);
+    cv::split(lab, channels);
+    EXPECT_LE(cv::norm(equalizer.getLightness(), channels[0], cv::NORM_INF), 2.0);
+
+    // 与 equalizeColor 相近
+    cv::Mat expected;
+    equalizeColor(image, expected, 2.0);
+    EXPECT_LT(cv::norm(equalized_image, expected, cv::NORM_L1) / expected.total() / 3, 10.0);
+
+    // 灰色输入保持灰色, 且可原地处理并复用
+    cv::Mat gray;
+    cv::cvtColor(image, gray, cv::COLOR_BGR2GRAY);
+    cv::cvtColor(gray, gray, cv::COLOR_GRAY2BGR);
+    equalizer.apply(gray, gray);
+    std::vector<cv::Mat> gray_channels;
+    cv::split(gray, gray_channels);
+    EXPECT_LE(cv::norm(gray_channels[0], gray_channels[1], cv::NORM_INF), 1.0);
+    EXPECT_LE(cv::norm(gray_channels[1], gray_channels[2], cv::NORM_INF), 1.0);
+
+    cv::imwrite("ColorEqualizer.jpg", equalized_image);
+}
+
+TEST(CvCoreTest, BufferPool)
+{
+    BufferPool &pool = BufferPool::instance();
+    pool.clear();
+    pool.resetStats();
+
+    cv::Mat buffer = pool.acquire(cv::Size(64, 48), CV_8UC3);
+    const uchar *data = buffer.data;
+    pool.release(buffer);
+    EXPECT_TRUE(buffer.empty());
+    buffer = pool.acquire(cv::Size(64, 48), CV_8UC3);
+    EXPECT_EQ(buffer.data, data);
+    BufferPool::STATS stats = pool.getStats();
+    EXPECT_EQ(stats.hits, 1);
+    EXPECT_EQ(stats.misses, 1);
+
+    // 仍被引用的缓冲不回收, 规格不同的申请不命中
+    cv::Mat alias = buffer;
+    pool.release(buffer);
+    cv::Mat other = pool.acquire(cv::Size(64, 48), CV_8UC3);
+    EXPECT_NE(other.data, alias.data);
+    pool.release(other);
+    other = pool.acquire(cv::Size(64, 48), CV_8UC1);
+    EXPECT_EQ(pool.getStats().misses, 3);
+
+    // 同一规格的帧重复处理时, 中间缓冲全部命中
+    cv::Mat image = cv::imread("test.jpg");
+    ASSERT_FALSE(image.empty());
+    cv::Mat equalized_image;
+    equalizeColor(image, equalized_image);
+    pool.resetStats();
+    equalizeColor(image, equalized_image);
+    stats = pool.getStats();
+    EXPECT_EQ(stats.misses, 0);
+    EXPECT_EQ(stats.hits, 2);
+
+    // 单次双边滤波不申请临时缓冲
+    pool.resetStats();
+    cv::Mat bilateral;
+    bilateralFilter(image, bilateral, 1, 9, 75, 75);
+    stats = pool.getStats();
+    EXPECT_EQ(stats.hits + stats.misses, 0);
+
+    // 其他线程缓存的缓冲可由 clear 释放
+    pool.clear();
+    EXPECT_EQ(pool.getStats().cachedBytes, 0);
+    std::atomic<bool> cached{false}, done{false};
+    std::thread worker([&]() {
+        cv::Mat local = pool.acquire(100, 100, CV_8UC1);
+        pool.release(local);
+        cached = true;
+        while (!done)
+            std::this_thread::yield();
+    });
+    while (!cached)
+        std::this_thread::yield();
+    EXPECT_EQ(pool.getStats().cachedBytes, 10000);
+    pool.clear();
+    EXPECT_EQ(pool.getStats().cachedBytes, 0);
+    done = true;
+    worker.join();
+
+    // 缓存总字节数上限
+    pool.setMaxCachedBytes(15000);
+    cv::Mat first = pool.acquire(100, 100, CV_8UC1), second = pool.acquire(100, 100, CV_8UC1);
+    pool.release(first);
+    pool.release(second);
+    EXPECT_EQ(pool.getStats().cachedBytes, 10000);
+    pool.setMaxCachedBytes(int64_t(256) << 20);
+    pool.clear();
+
+    // 帧作用域结束时只保留本帧用到的规格
+    {
+        BufferPool::FrameScope frame;
+        PooledMat small(cv::Size(10, 10), CV_8UC1);
+    }
+    EXPECT_EQ(pool.getStats().cachedBytes, 100);
+    {
+        BufferPool::FrameScope frame;
+        PooledMat large(cv::Size(20, 20), CV_8UC1);
+    }
+    EXPECT_EQ(pool.getStats().cachedBytes, 400);
+    pool.clear();
+}
+
 TEST(CvCoreTest, BilateralFilter)
 {
     cv::Mat image = cv::imread("test.jpg");
@@ -205,6 +613,46 @@ TEST(CvCoreTest, BilateralFilter)
     cv::imwrite("BilateralFilter.jpg", filtered_image);
 }
 
+TEST(CvCoreTest, BilateralFilterModes)
+{
+    cv::Mat image = cv::imread("test.jpg");
+    ASSERT_FALSE(image.empty());
+    cv::resize(image, image, cv::Size(160, 120));
+
+    // 与逐次调用 cv::bilateralFilter 一致, 偶数次迭代与原地调用同样成立
+    for (int iter : {1, 2, 3})
+    {
+        cv::Mat expected = image.clone(), temp;
+        for (int i = 0; i < iter; i++)
+        {
+            cv::bilateralFilter(expected, temp, 9, 75, 75);
+            expected = temp.clone();
+        }
+        cv::Mat filtered_image;
+        bilateralFilter(image, filtered_image, iter, 9, 75, 75);
+        EXPECT_EQ(cv::norm(filtered_image, expected, cv::NORM_INF), 0.0) << iter;
+        cv::Mat inplace = image.clone();
+        bilateralFilter(inplace, inplace, iter, 9, 75, 75);
+        EXPECT_EQ(cv::norm(inplace, expected, cv::NORM_INF), 0.0) << iter;
+    }
+
+    // 导向滤波近似: 平坦区域平滑噪声, 保留强边缘
+    cv::Mat step(64, 64, CV_8UC1, cv::Scalar::all(40));
+    step.colRange(32, 64).setTo(cv::Scalar::all(200));
+    cv::Mat noise(step.size(), CV_8UC1);
+    cv::randu(noise, cv::Scalar::all(0), cv::Scalar::all(9));
+    cv::Mat noisy = step + noise;
+    cv::Mat smoothed;
+    bilateralFilter(noisy, smoothed, 2, 9, 20, 20, BILATERAL_MODE::GUIDED);
+    ASSERT_EQ(smoothed.type(), CV_8UC1);
+    cv::Scalar mean_noisy, std_noisy, mean_smoothed, std_smoothed;
+    cv::meanStdDev(noisy(cv::Rect(4, 4, 20, 56)), mean_noisy, std_noisy);
+    cv::meanStdDev(smoothed(cv::Rect(4, 4, 20, 56)), mean_smoothed, std_smoothed);
+    EXPECT_LT(std_smoothed[0], std_noisy[0]);
+    EXPECT_LT(smoothed.at<uchar>(30, 30), 60);
+    EXPECT_GT(smoothed.at<uchar>(30, 33), 180);
+}
+
 TEST(CvCoreTest, GaborFilter)
 {
     cv::Mat image = cv::imread("test.jpg");
@@ -221,6 +669,50 @@ TEST(CvCoreTest, GaborFilter)
     cv::imwrite("GaborFilter.jpg", gabor_image);
 }
 
+TEST(CvCoreTest, GaborBank)
+{
+    cv::Mat image = cv::imread("test.jpg");
+    ASSERT_FALSE(image.empty());
+    cv::cvtColor(image, image, cv::COLOR_BGR2GRAY);
+    cv::resize(image, image, cv::Size(123, 97));
+    cv::Mat src;
+    image.convertTo(src, CV_32F);
+
+    // FFT 路径与空间域路径均与 filter2D 一致
+    for (int fft_min_kernel_size : {15, 100})
+    {
+        GaborBank bank(21, 4.0, 8, {8.0, 12.0}, 0.5, CV_PI * 0.5, fft_min_kernel_size);
+        ASSERT_EQ(bank.getOrientationNum(), 8);
+        ASSERT_EQ(bank.getLambdaNum(), 2);
+
+        std::vector<cv::Mat> responses;
+        bank.apply(image, responses);
+        ASSERT_EQ(responses.size(), 16u);
+        for (int m = 0; m < 2; m++)
+        {
+            for (int n = 0; n < 8; n += 3)
+            {
+                cv::Mat expected;
+                cv::filter2D(src, expected, CV_32F, bank.getKernel(m, n));
+                const cv::Mat &actual = responses[m * 8 + n];
+                ASSERT_EQ(actual.size(), image.size());
+                EXPECT_LT(cv::norm(actual, expected, cv::NORM_INF), 1e-2 * (1 + cv::norm(expected, cv::NORM_INF)));
+            }
+        }
+
+        // 再次调用复用缓存的频谱
+        cv::Mat energy;
+        bank.applyMaxEnergy(image, energy);
+        ASSERT_EQ(energy.type(), CV_32FC2);
+        cv::Mat expected = cv::abs(responses[8]);
+        for (int n = 1; n < 8; n++)
+            expected = cv::max(expected, cv::abs(responses[8 + n]));
+        std::vector<cv::Mat> channels;
+        cv::split(energy, channels);
+        EXPECT_LT(cv::norm(channels[1], expected, cv::NORM_INF), 1e-3 * (1 + cv::norm(expected, cv::NORM_INF)));
+    }
+}
+
 TEST(CvCoreTest, LBP)
 {
     cv::Mat image = cv::imread("test.jpg");
@@ -234,6 +726,593 @@ TEST(CvCoreTest, LBP)
     cv::imwrite("LBP.jpg", lbp_image);
 }
 
+TEST(CvCoreTest, LBPVariants)
+{
+    cv::Mat image(37, 53, CV_8UC1);
+    cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(256));
+
+    // 与逐像素实现对比
+    cv::Mat lbp_image;
+    LBP(image, lbp_image);
+    ASSERT_EQ(lbp_image.size(), image.size());
+    for (int i = 1; i < image.rows - 1; i++)
+    {
+        for (int j = 1; j < image.cols - 1; j++)
+        {
+            uchar center = image.at<uchar>(i, j);
+            uchar code = 0;
+            code |= (image.at<uchar>(i - 1, j - 1) >= center) << 7;
+            code |= (image.at<uchar>(i - 1, j) >= center) << 6;
+            code |= (image.at<uchar>(i - 1, j + 1) >= center) << 5;
+            code |= (image.at<uchar>(i, j + 1) >= center) << 4;
+            code |= (image.at<uchar>(i + 1, j + 1) >= center) << 3;
+            code |= (image.at<uchar>(i + 1, j) >= center) << 2;
+            code |= (image.at<uchar>(i + 1, j - 1) >= center) << 1;
+            code |= (image.at<uchar>(i, j - 1) >= center) << 0;
+            ASSERT_EQ(lbp_image.at<uchar>(i, j), code);
+        }
+    }
+
+    for (LBP_TYPE type : {LBP_TYPE::UNIFORM, LBP_TYPE::ROTATION_INVARIANT, LBP_TYPE::UNIFORM_ROTATION_INVARIANT})
+    {
+        cv::Mat codes;
+        calcLBP(image, codes, type);
+        double maxVal = 0;
+        cv::minMaxLoc(codes, nullptr, &maxVal);
+        EXPECT_LT(maxVal, getLBPBinNum(type));
+
+        cv::Mat hist;
+        calcLBPHist(image, hist, cv::Size(16, 16), type, false);
+        EXPECT_EQ(hist.rows, 2 * 3);
+        EXPECT_EQ(hist.cols, getLBPBinNum(type));
+        // 左上角块去掉首行首列后共 15x15 个像素
+        EXPECT_FLOAT_EQ(static_cast<float>(cv::sum(hist.row(0))[0]), 15.0f * 15.0f);
+        for (int b = 0; b < hist.cols; b++)
+        {
+            int count = cv::countNonZero(codes(cv::Rect(1, 1, 15, 15)) == b);
+            EXPECT_FLOAT_EQ(hist.at<float>(0, b), static_cast<float>(count));
+        }
+    }
+
+    // 等价模式: 全 0 与全 1 编码之外, 旋转不变等价模式类别等于 1 的个数
+    cv::Mat flat(5, 5, CV_8UC1, cv::Scalar::all(100)), codes;
+    calcLBP(flat, codes, LBP_TYPE::UNIFORM_ROTATION_INVARIANT);
+    EXPECT_EQ(codes.at<uchar>(2, 2), 8);
+}
+
+TEST(CvCoreTest, CircularLBP)
+{
+    cv::Mat image(48, 64, CV_8UC1);
+    cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(256));
+
+    CircularLBP lbp({{8, 1}, {16, 2}, {24, 3}});
+    ASSERT_EQ(lbp.getSamplingNum(), 3);
+    EXPECT_EQ(lbp.getBorder(0), 1);
+    EXPECT_EQ(lbp.getBorder(2), 3);
+    EXPECT_EQ(lbp.getBinNum(0, LBP_TYPE::ROTATION_INVARIANT), 36);
+    EXPECT_EQ(lbp.getBinNum(1, LBP_TYPE::UNIFORM), 16 * 15 + 3);
+    EXPECT_EQ(lbp.getBinNum(2, LBP_TYPE::UNIFORM_ROTATION_INVARIANT), 26);
+
+    // 与逐像素双线性插值对比
+    cv::Mat codes;
+    lbp.compute(image, codes);
+    ASSERT_EQ(codes.type(), CV_32SC3);
+    const int neighbors[3] = {8, 16, 24};
+    const double radius[3] = {1, 2, 3};
+    for (int k = 0; k < 3; k++)
+    {
+        for (cv::Point pt : {cv::Point(3, 3), cv::Point(20, 17), cv::Point(60, 44)})
+        {
+            int code = 0;
+            uchar center = image.at<uchar>(pt);
+            for (int p = 0; p < neighbors[k]; p++)
+            {
+                double angle = 2.0 * CV_PI * p / neighbors[k];
+                double y = pt.y - radius[k] * std::sin(angle);
+                double x = pt.x + radius[k] * std::cos(angle);
+                int y0 = static_cast<int>(std::floor(y + 1e-6)), x0 = static_cast<int>(std::floor(x + 1e-6));
+                double ty = std::max(y - y0, 0.0), tx = std::max(x - x0, 0.0);
+                double v = (1 - ty) * (1 - tx) * image.at<uchar>(y0, x0);
+                if (tx > 1e-6)
+                    v += (1 - ty) * tx * image.at<uchar>(y0, x0 + 1);
+                if (ty > 1e-6)
+                    v += ty * (1 - tx) * image.at<uchar>(y0 + 1, x0);
+                if (tx > 1e-6 && ty > 1e-6)
+                    v += ty * tx * image.at<uchar>(y0 + 1, x0 + 1);
+                code |= (v + 1e-4 >= center) << p;
+            }
+            EXPECT_EQ(codes.at<cv::Vec3i>(pt)[k], code) << "sampling " << k << " at " << pt;
+        }
+    }
+    EXPECT_EQ(codes.at<cv::Vec3i>(2, 2)[2], 0);
+
+    // 平坦图像的邻域全部 >= 中心
+    cv::Mat flat(16, 16, CV_8UC1, cv::Scalar::all(100));
+    lbp.compute(flat, codes, LBP_TYPE::UNIFORM_ROTATION_INVARIANT);
+    EXPECT_EQ(codes.at<cv::Vec3i>(8, 8), cv::Vec3i(8, 16, 24));
+    lbp.compute(flat, codes, LBP_TYPE::UNIFORM);
+    EXPECT_EQ(codes.at<cv::Vec3i>(8, 8), cv::Vec3i(8 * 7 + 1, 16 * 15 + 1, 24 * 23 + 1));
+
+    cv::Mat hist;
+    lbp.computeHist(image, hist, cv::Size(16, 16), LBP_TYPE::UNIFORM_ROTATION_INVARIANT, false);
+    EXPECT_EQ(hist.rows, 3 * 4);
+    EXPECT_EQ(hist.cols, 10 + 18 + 26);
+    EXPECT_FLOAT_EQ(static_cast<float>(cv::sum(hist.row(0).colRange(0, 10))[0]), 15.0f * 15.0f);
+    EXPECT_FLOAT_EQ(static_cast<float>(cv::sum(hist.row(0).colRange(28, 54))[0]), 13.0f * 13.0f);
+    lbp.computeHist(image, hist, cv::Size(16, 16));
+    EXPECT_NEAR(cv::sum(hist.row(5))[0], 3.0, 1e-4);
+
+    EXPECT_THROW(lbp.compute(image, codes, LBP_TYPE::ROTATION_INVARIANT), cv::Exception);
+}
+
+TEST(CvCoreTest, TileExecutor)
+{
+    cv::Mat image = cv::imread("test.jpg", cv::IMREAD_GRAYSCALE);
+    ASSERT_FALSE(image.empty());
+
+    // 块尺寸不整除图像尺寸, 检查边缘块和拼接处
+    TileExecutor executor(cv::Size(37, 29));
+    std::vector<cv::Rect> tiles;
+    executor.getTiles(image.size(), tiles);
+    int area = 0;
+    for (const cv::Rect &tile : tiles)
+        area += tile.area();
+    EXPECT_EQ(area, image.rows * image.cols);
+
+    // LBP 的 Halo 为 1
+    cv::Mat expected, tiled;
+    calcLBP(image, expected, LBP_TYPE::UNIFORM);
+    executor.run(image, tiled, expected.type(), 1, [](const cv::Mat &In, cv::Mat &Out) {
+        calcLBP(In, Out, LBP_TYPE::UNIFORM);
+    });
+    EXPECT_EQ(cv::norm(expected, tiled, cv::NORM_INF), 0.0);
+
+    // Gabor 卷积的 Halo 为 kernel / 2
+    cv::Mat kernel = cv::getGaborKernel(cv::Size(15, 15), 4.0, CV_PI / 4, 8.0, 0.5, CV_PI / 2, CV_32F);
+    cv::filter2D(image, expected, CV_32F, kernel);
+    executor.run(image, tiled, CV_32FC1, kernel.rows / 2, [&kernel](const cv::Mat &In, cv::Mat &Out) {
+        cv::filter2D(In, Out, CV_32F, kernel);
+    });
+    EXPECT_LE(cv::norm(expected, tiled, cv::NORM_INF), 1e-3);
+
+    // 点运算无需 Halo, 且可原地处理
+    cv::Mat lut;
+    linearLevelLut(50, 200, 0, 255, lut);
+    cv::LUT(image, lut, expected);
+    tiled = image.clone();
+    executor.run(tiled, tiled, CV_8UC1, 0, [&lut](const cv::Mat &In, cv::Mat &Out) {
+        cv::LUT(In, lut, Out);
+    });
+    EXPECT_EQ(cv::norm(expected, tiled, cv::NORM_INF), 0.0);
+
+    EXPECT_THROW(executor.setTileSize(cv::Size(0, 16)), cv::Exception);
+}
+
+TEST(CvCoreTest, TileExecutorBenchmark)
+{
+    cv::Mat image(4096, 4096, CV_8UC1);
+    cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(256));
+    cv::Mat kernel = cv::getGaborKernel(cv::Size(15, 15), 4.0, 0.0, 8.0, 0.5, CV_PI / 2, CV_32F);
+
+    TileExecutor executor;
+    const int maxThreads = cv::getNumThreads();
+    cv::Mat result;
+    cv::TickMeter tm;
+    for (int threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        cv::setNumThreads(threads);
+        tm.reset();
+        tm.start();
+        executor.run(image, result, CV_8UC1, 1, [](const cv::Mat &In, cv::Mat &Out) {
+            calcLBP(In, Out, LBP_TYPE::UNIFORM);
+        });
+        tm.stop();
+        double lbp_ms = tm.getTimeMilli();
+
+        tm.reset();
+        tm.start();
+        executor.run(image, result, CV_32FC1, kernel.rows / 2, [&kernel](const cv::Mat &In, cv::Mat &Out) {
+            cv::filter2D(In, Out, CV_32F, kernel);
+        });
+        tm.stop();
+        std::cout << "threads: " << threads << ", tile: " << executor.getTileSize()
+                  << ", lbp: " << lbp_ms << " ms, gabor: " << tm.getTimeMilli() << " ms" << std::endl;
+    }
+    cv::setNumThreads(maxThreads);
+}
+
+TEST(CvCoreTest, Pipeline)
+{
+    cv::Mat image = cv::imread("test.jpg");
+    ASSERT_FALSE(image.empty());
+
+    // 手写的串联代码
+    BOX_RECT expectedPads;
+    cv::Mat padded, equalized, blurred, gray, expectedMask, expectedLbp;
+    letterbox(image, padded, expectedPads, cv::Size(320, 320));
+    equalizeColor(padded, equalized);
+    cv::GaussianBlur(equalized, blurred, cv::Size(3, 3), 0);
+    cv::cvtColor(blurred, gray, cv::COLOR_BGR2GRAY);
+    gammaImage(gray, expectedMask, 0.8f);
+    threshold(expectedMask, expectedMask, 100, 255);
+    calcLBP(gray, expectedLbp);
+    RegionSet expectedRegions;
+    int expectedNum = connection(expectedMask, expectedRegions);
+
+    BOX_RECT pads;
+    int regionNum = 0;
+    Pipeline pipeline;
+    int boxed = pipeline.addLetterbox(Pipeline::INPUT, cv::Size(320, 320), cv::Scalar(128, 128, 128), &pads);
+    int equal = pipeline.addEqualizeColor(boxed);
+    int blur = pipeline.addStage("GaussianBlur", equal, [](const cv::Mat &InMat, cv::Mat &OutMat) {
+        cv::GaussianBlur(InMat, OutMat, cv::Size(3, 3), 0);
+    });
+    int grayNode = pipeline.addStage("cvtColor", blur, [](const cv::Mat &InMat, cv::Mat &OutMat) {
+        cv::cvtColor(InMat, OutMat, cv::COLOR_BGR2GRAY);
+    });
+    PointOpChain gamma;
+    gamma.gamma(0.8f);
+    int gammaNode = pipeline.addPointOp("gamma", grayNode, gamma);
+    int mask = pipeline.addThreshold(gammaNode, 100, 255);
+    int lbp = pipeline.addStage("LBP", grayNode, [](const cv::Mat &InMat, cv::Mat &OutMat) {
+        calcLBP(InMat, OutMat);
+    });
+    pipeline.addSink("connection", mask, [&regionNum](const cv::Mat &InMat) {
+        RegionSet regions;
+        regionNum = connection(InMat, regions);
+    });
+    pipeline.setOutput(mask);
+    pipeline.setOutput(lbp);
+
+    // gamma 与 threshold 融合为一个阶段; 首次 run 前输出尺寸未知, 各阶段独占缓冲
+    EXPECT_EQ(pipeline.getStageNum(), 7);
+    EXPECT_EQ(pipeline.getBufferNum(), 6);
+
+    std::vector<cv::Mat> outputs;
+    std::vector<const uchar *> addresses;
+    for (int i = 0; i < 3; i++)
+    {
+        pipeline.run(image, outputs);
+        ASSERT_EQ(outputs.size(), 2u);
+        EXPECT_EQ(cv::norm(outputs[0], expectedMask, cv::NORM_INF), 0.0);
+        EXPECT_EQ(cv::norm(outputs[1], expectedLbp, cv::NORM_INF), 0.0);
+        EXPECT_EQ(regionNum, expectedNum);
+        EXPECT_EQ(pads.top, expectedPads.top);
+        EXPECT_EQ(pads.left, expectedPads.left);
+
+        // 首次 run 后按尺寸类型重新规划: GaussianBlur 复用 letterbox 的 CV_8UC3 缓冲, 之后缓冲地址不变
+        if (i == 0)
+            EXPECT_EQ(pipeline.getBufferNum(), 5);
+        std::vector<const uchar *> current;
+        for (int k = 0; k < pipeline.getBufferNum(); k++)
+            current.push_back(pipeline.getBuffer(k).data);
+        if (i == 2)
+            EXPECT_EQ(current, addresses);
+        addresses = current;
+    }
+    int colorBuffers = 0;
+    for (int k = 0; k < pipeline.getBufferNum(); k++)
+        colorBuffers += (pipeline.getBuffer(k).type() == CV_8UC3);
+    EXPECT_EQ(colorBuffers, 2);
+
+    const std::vector<Pipeline::STAGE_TIME> &timings = pipeline.getTimings();
+    ASSERT_EQ(timings.size(), 7u);
+    EXPECT_EQ(timings[4].Name, "gamma+threshold");
+    for (const Pipeline::STAGE_TIME &t : timings)
+    {
+        EXPECT_GE(t.Milliseconds, 0.0);
+        std::cout << t.Name << ": " << t.Milliseconds << " ms" << std::endl;
+    }
+
+    EXPECT_THROW(pipeline.addStage("bad", 100, [](const cv::Mat &, cv::Mat &) {}), cv::Exception);
+}
+
+TEST(CvCoreTest, RingQueue)
+{
+    RingQueue<int> queue(3);
+    EXPECT_EQ(queue.capacity(), 4u);
+    for (int i = 0; i < 4; i++)
+        EXPECT_TRUE(queue.tryPush(int(i)));
+    EXPECT_FALSE(queue.tryPush(4));
+    int value = -1;
+    EXPECT_TRUE(queue.tryPop(value));
+    EXPECT_EQ(value, 0);
+    EXPECT_TRUE(queue.tryPush(4));
+
+    // 单生产者单消费者, 顺序不变
+    const int num = 100000;
+    int64_t sum = 0;
+    bool ordered = true;
+    std::thread consumer([&]() {
+        int expected = 1, v = 0;
+        while (expected <= num + 3)
+        {
+            if (!queue.tryPop(v))
+                continue;
+            ordered = ordered && (v == expected);
+            sum += v;
+            expected++;
+        }
+    });
+    for (int i = 5; i <= num + 3; i++)
+    {
+        while (!queue.tryPush(int(i)))
+            std::this_thread::yield();
+    }
+    consumer.join();
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(sum, static_cast<int64_t>(num + 3) * (num + 4) / 2);
+}
+
+TEST(CvCoreTest, StreamRunner)
+{
+    const int frameNum = 30;
+    auto sleepMs = [](int Ms) { std::this_thread::sleep_for(std::chrono::milliseconds(Ms)); };
+
+    // 解码 -> 预处理 -> 推理 -> 后处理, 推理最慢
+    const int capacity = 4;
+    StreamRunner runner(capacity);
+    std::atomic<int> produced{0}, finished{0};
+    int maxInFlight = 0; // 已读取但未完成后处理的帧数峰值, 仅数据源线程写入
+    runner.setSource("decode", [&](STREAM_FRAME &Frame) {
+        if (produced == frameNum)
+            return false;
+        sleepMs(4);
+        Frame.Image = cv::Mat(48, 64, CV_8UC3, cv::Scalar::all(produced % 256));
+        produced++;
+        maxInFlight = std::max(maxInFlight, produced - finished);
+        return true;
+    });
+    runner.addStage("letterbox", [&](STREAM_FRAME &Frame) {
+        sleepMs(4);
+        BOX_RECT pads;
+        letterbox(Frame.Image, Frame.Processed, pads, cv::Size(64, 64));
+    });
+    runner.addStage("detect", [&](STREAM_FRAME &Frame) {
+        sleepMs(10);
+        Frame.Data = static_cast<int>(Frame.Processed.at<cv::Vec3b>(32, 32)[0]);
+    });
+    std::vector<int64_t> indices;
+    bool consistent = true, overlapped = false;
+    runner.addStage("visualize", [&](STREAM_FRAME &Frame) {
+        // 第 0 帧后处理完成前, 数据源应已独立读取后续帧; 串行执行时只能等到超时
+        if (Frame.Index == 0)
+        {
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+            while (produced < 4 && std::chrono::steady_clock::now() < deadline)
+                sleepMs(1);
+            overlapped = produced >= 4;
+        }
+        sleepMs(4);
+        indices.push_back(Frame.Index);
+        consistent = consistent && std::any_cast<int>(Frame.Data) == Frame.Index % 256;
+        finished++;
+    });
+
+    auto begin = std::chrono::steady_clock::now();
+    runner.run();
+    double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+    ASSERT_EQ(indices.size(), static_cast<size_t>(frameNum));
+    for (int i = 0; i < frameNum; i++)
+        EXPECT_EQ(indices[i], i);
+    EXPECT_TRUE(consistent);
+    // 各阶段重叠执行, 且在途帧数受队列容量约束: 3 条队列 + 4 个线程各持有一帧
+    EXPECT_TRUE(overlapped);
+    EXPECT_GE(maxInFlight, 4);
+    EXPECT_LE(maxInFlight, 3 * capacity + 4);
+    std::cout << "stream: " << elapsed << " ms, serial >= " << frameNum * 22 << " ms, max in flight: " << maxInFlight << std::endl;
+    for (const StreamRunner::STAGE_STATS &stat : runner.getStats())
+    {
+        EXPECT_EQ(stat.Frames, frameNum);
+        EXPECT_EQ(stat.Dropped, 0);
+    }
+
+    // 慢速阶段前丢弃最旧的帧, 保留的帧依然有序且最后一帧不会丢失
+    StreamRunner dropRunner(2);
+    int64_t next = 0;
+    dropRunner.setSource("camera", [&](STREAM_FRAME &) { return next++ < frameNum; });
+    std::vector<int64_t> kept;
+    dropRunner.addStage("slow", [&](STREAM_FRAME &Frame) {
+        sleepMs(5);
+        kept.push_back(Frame.Index);
+    }, DROP_POLICY::DROP_OLDEST);
+    dropRunner.run();
+    ASSERT_FALSE(kept.empty());
+    EXPECT_LT(kept.size(), static_cast<size_t>(frameNum));
+    EXPECT_TRUE(std::is_sorted(kept.begin(), kept.end()));
+    EXPECT_EQ(kept.back(), frameNum - 1);
+    std::vector<StreamRunner::STAGE_STATS> stats = dropRunner.getStats();
+    EXPECT_EQ(stats[1].Frames + stats[1].Dropped, frameNum);
+
+    // 阶段中的异常在 wait 中重新抛出
+    StreamRunner failRunner(2);
+    failRunner.setSource("source", [](STREAM_FRAME &) { return true; });
+    failRunner.addStage("fail", [](STREAM_FRAME &) { CV_Error(cv::Error::StsError, "stage failed"); });
+    EXPECT_THROW(failRunner.run(), cv::Exception);
+}
+
+TEST(CvCoreTest, ImageSource)
+{
+    cv::Mat image = cv::imread("test.jpg");
+    ASSERT_FALSE(image.empty());
+
+    // 生成内容各不相同的测试图像, 中间夹一个不存在的文件
+    const int imageNum = 12;
+    std::vector<std::string> paths;
+    for (int i = 0; i < imageNum; i++)
+    {
+        cv::Mat marked = image.clone();
+        cv::putText(marked, std::to_string(i), cv::Point(20, 60), cv::FONT_HERSHEY_SIMPLEX, 2.0, cv::Scalar(0, 0, 255), 3);
+        paths.push_back("image_source_" + std::to_string(i) + ".jpg");
+        ASSERT_TRUE(cv::imwrite(paths.back(), marked));
+    }
+    paths.insert(paths.begin() + 5, "image_source_missing.jpg");
+
+    IMAGE_SOURCE_PARAM param;
+    param.ThreadNum = 4;
+    param.QueueSize = 3;
+    {
+        ImageSource source(paths, param);
+        EXPECT_EQ(source.size(), paths.size());
+        cv::Mat frame;
+        int index = -1, count = 0;
+        while (source.next(frame, &index))
+        {
+            EXPECT_EQ(index, count);
+            if (index == 5)
+            {
+                EXPECT_TRUE(frame.empty());
+            }
+            else
+            {
+                cv::Mat expected = cv::imread(paths[index]);
+                ASSERT_EQ(frame.size(), expected.size());
+                EXPECT_EQ(cv::norm(frame, expected, cv::NORM_INF), 0.0);
+            }
+            source.recycle(frame);
+            count++;
+        }
+        EXPECT_EQ(count, static_cast<int>(paths.size()));
+        EXPECT_FALSE(source.next(frame));
+    }
+
+    // 无序输出时每张图像恰好出现一次; 缩小解码与 cv::imread 一致
+    param.Ordered = false;
+    param.Flags = ImageSource::getReducedFlags(cv::IMREAD_COLOR, 2);
+    {
+        ImageSource source(paths, param);
+        std::vector<int> seen(paths.size(), 0);
+        cv::Mat frame;
+        int index = -1;
+        while (source.next(frame, &index))
+        {
+            seen[index]++;
+            if (!frame.empty())
+            {
+                cv::Mat expected = cv::imread(paths[index], cv::IMREAD_REDUCED_COLOR_2);
+                EXPECT_EQ(cv::norm(frame, expected, cv::NORM_INF), 0.0);
+            }
+        }
+        EXPECT_EQ(std::count(seen.begin(), seen.end(), 1), static_cast<std::ptrdiff_t>(paths.size()));
+    }
+
+    // 提前析构不阻塞
+    {
+        ImageSource source(paths, param);
+        cv::Mat frame;
+        EXPECT_TRUE(source.next(frame));
+    }
+
+    EXPECT_EQ(ImageSource::getReducedFlags(cv::IMREAD_GRAYSCALE, 4), cv::IMREAD_REDUCED_GRAYSCALE_4);
+    EXPECT_EQ(ImageSource::getReduceFactor(cv::Size(1920, 1080), cv::Size(640, 360)), 2);
+    EXPECT_EQ(ImageSource::getReduceFactor(cv::Size(4000, 3000), cv::Size(320, 320)), 8);
+    EXPECT_EQ(ImageSource::getReduceFactor(cv::Size(640, 480), cv::Size(640, 640)), 1);
+    EXPECT_THROW(ImageSource::getReducedFlags(cv::IMREAD_COLOR, 3), cv::Exception);
+
+    for (int i = 0; i < imageNum; i++)
+        std::remove(("image_source_" + std::to_string(i) + ".jpg").c_str());
+}
+
+TEST(CvCoreTest, RawFrameFile)
+{
+    // 16 位线扫图像, 整行分块
+    cv::Mat image16(700, 333, CV_16UC1);
+    cv::randu(image16, cv::Scalar::all(0), cv::Scalar::all(65536));
+    RawFrameFile::write("raw_frame_16u.raw", image16, cv::Size(0, 128));
+
+    RawFrameFile file;
+    file.open("raw_frame_16u.raw");
+    ASSERT_TRUE(file.isOpen());
+    EXPECT_EQ(file.getSize(), image16.size());
+    EXPECT_EQ(file.getType(), CV_16UC1);
+    EXPECT_EQ(file.getStride() % 64, 0u);
+    ASSERT_EQ(file.getTileNum(), 6);
+    EXPECT_EQ(file.getTileRect(5), cv::Rect(0, 640, 333, 60));
+    cv::Mat view = file.getMat();
+    EXPECT_EQ(cv::norm(view, image16, cv::NORM_INF), 0.0);
+
+    // 分块视图直接指向映射的页
+    cv::Mat tile = file.getTile(2);
+    EXPECT_EQ(tile.data, view.ptr(256));
+    EXPECT_EQ(file.getTile(2, 1).rows, 130);
+    EXPECT_EQ(file.getTile(0, 1).rows, 129);
+    file.prefetchTile(3);
+    file.evictTile(2);
+    EXPECT_EQ(cv::norm(file.getTile(2), image16.rowRange(256, 384), cv::NORM_INF), 0.0);
+    file.close();
+    EXPECT_FALSE(file.isOpen());
+
+    // 8 位图像逐块阈值分割与整幅处理一致
+    cv::Mat image8 = cv::imread("test.jpg", cv::IMREAD_GRAYSCALE);
+    ASSERT_FALSE(image8.empty());
+    RawFrameFile::write("raw_frame_8u.raw", image8, cv::Size(64, 64));
+    file.open("raw_frame_8u.raw");
+    cv::Mat expected, tiled(image8.size(), CV_8UC1);
+    threshold(image8, expected, 100, 255);
+    for (int i = 0; i < file.getTileNum(); i++)
+    {
+        cv::Mat dst = tiled(file.getTileRect(i));
+        threshold(file.getTile(i), dst, 100, 255);
+    }
+    EXPECT_EQ(cv::norm(expected, tiled, cv::NORM_INF), 0.0);
+    RegionSet regions, fileRegions;
+    cv::Mat fileMask;
+    threshold(file.getMat(), fileMask, 100, 255);
+    EXPECT_EQ(connection(fileMask, fileRegions), connection(expected, regions));
+    file.close();
+
+    // 可写映射的修改写回文件
+    file.open("raw_frame_8u.raw", true);
+    file.getTile(0).setTo(cv::Scalar::all(7));
+    file.flush();
+    file.close();
+    file.open("raw_frame_8u.raw");
+    EXPECT_EQ(file.getMat().at<uchar>(3, 3), 7);
+    file.close();
+
+    // 非原始帧文件
+    {
+        std::ofstream bad("raw_frame_bad.raw", std::ios::binary);
+        bad << std::string(128, 'x');
+    }
+    EXPECT_THROW(file.open("raw_frame_bad.raw"), cv::Exception);
+    EXPECT_FALSE(file.isOpen());
+    EXPECT_THROW(file.open("raw_frame_missing.raw"), cv::Exception);
+
+    // 行跨度或数据偏移未按元素大小对齐; 文件末尾补零, 使其余校验均可通过
+    auto patchHeader = [](std::streamoff Offset, uint64_t Value) {
+        std::fstream raw("raw_frame_16u.raw", std::ios::binary | std::ios::in | std::ios::out);
+        raw.seekp(Offset);
+        raw.write(reinterpret_cast<const char *>(&Value), sizeof(Value));
+    };
+    uint64_t stride = 0, offset = 0;
+    {
+        std::ifstream raw("raw_frame_16u.raw", std::ios::binary);
+        raw.seekg(24);
+        raw.read(reinterpret_cast<char *>(&stride), sizeof(stride));
+        raw.seekg(40);
+        raw.read(reinterpret_cast<char *>(&offset), sizeof(offset));
+    }
+    {
+        std::ofstream raw("raw_frame_16u.raw", std::ios::binary | std::ios::app);
+        raw << std::string(4096, '\0');
+    }
+    patchHeader(40, offset + 2);
+    EXPECT_NO_THROW(file.open("raw_frame_16u.raw"));
+    file.close();
+    patchHeader(40, offset + 1);
+    EXPECT_THROW(file.open("raw_frame_16u.raw"), cv::Exception);
+    patchHeader(40, offset);
+    patchHeader(24, stride + 1);
+    EXPECT_THROW(file.open("raw_frame_16u.raw"), cv::Exception);
+    EXPECT_FALSE(file.isOpen());
+
+    std::remove("raw_frame_16u.raw");
+    std::remove("raw_frame_8u.raw");
+    std::remove("raw_frame_bad.raw");
+}
+
 } // namespace pcv
 
 int main(int argc, char **argv)
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "glcm/cv_glcm.h"
+#include "core/cv_stats.h"
 #include <iostream>
 
 TEST(GLCMTest, GLCM)
@@ -45,6 +46,62 @@ TEST(GLCMTest, GLCM)
     }
 }
 
+/// @brief 逐像素串行统计的参考实现
+static cv::Mat referenceGlcm(const cv::Mat &Gray, int Dx, int Dy, int Levels)
+{
+    cv::Mat glcm = cv::Mat::zeros(Levels, Levels, CV_32F);
+    for (int i = 0; i < Gray.rows; ++i)
+    {
+        for (int j = 0; j < Gray.cols; ++j)
+        {
+            if (i + Dy >= 0 && i + Dy < Gray.rows && j + Dx >= 0 && j + Dx < Gray.cols)
+            {
+                glcm.at<float>(Gray.at<uchar>(i, j), Gray.at<uchar>(i + Dy, j + Dx))++;
+            }
+        }
+    }
+    return glcm / cv::sum(glcm)[0];
+}
+
+TEST(GLCMTest, MatchesSerialCount)
+{
+    const pcv::GLCM::GLCM_TYPE types[4] = {pcv::GLCM::GLCM_TYPE::GLCM_0, pcv::GLCM::GLCM_TYPE::GLCM_45,
+                                           pcv::GLCM::GLCM_TYPE::GLCM_90, pcv::GLCM::GLCM_TYPE::GLCM_135};
+    const int offsets[4][2] = {{1, 0}, {1, -1}, {0, 1}, {1, 1}};
+    // 小图像走串行路径, 大图像分条带并行
+    for (cv::Size size : {cv::Size(23, 17), cv::Size(640, 480)})
+    {
+        cv::Mat gray(size, CV_8UC1);
+        cv::randu(gray, cv::Scalar::all(0), cv::Scalar::all(8));
+        for (int t = 0; t < 4; t++)
+        {
+            cv::Mat input = gray.clone(), glcm_mat;
+            pcv::GLCM::calcGlcmMat(input, glcm_mat, types[t], pcv::GLCM::GRAY_LEVEL::GL_8);
+            cv::Mat expected = referenceGlcm(gray, offsets[t][0], offsets[t][1], 8);
+            ASSERT_EQ(glcm_mat.type(), CV_32FC1);
+            EXPECT_LE(cv::norm(glcm_mat, expected, cv::NORM_INF), 1e-6) << size << " type " << t;
+        }
+    }
+}
+
+TEST(GLCMTest, PrecomputedStats)
+{
+    // 最大灰度超过灰度级, 两个重载都要先量化
+    cv::Mat gray(120, 160, CV_8UC1);
+    cv::randu(gray, cv::Scalar::all(0), cv::Scalar::all(200));
+    const pcv::GLCM::GLCM_TYPE types[4] = {pcv::GLCM::GLCM_TYPE::GLCM_0, pcv::GLCM::GLCM_TYPE::GLCM_45,
+                                           pcv::GLCM::GLCM_TYPE::GLCM_90, pcv::GLCM::GLCM_TYPE::GLCM_135};
+    pcv::ImageStats stats(gray);
+    for (pcv::GLCM::GLCM_TYPE type : types)
+    {
+        cv::Mat input = gray.clone(), statsInput = gray.clone(), glcm_mat, stats_glcm_mat;
+        pcv::GLCM::calcGlcmMat(input, glcm_mat, type, pcv::GLCM::GRAY_LEVEL::GL_16);
+        pcv::GLCM::calcGlcmMat(statsInput, stats_glcm_mat, stats, type, pcv::GLCM::GRAY_LEVEL::GL_16);
+        EXPECT_EQ(cv::norm(input, statsInput, cv::NORM_INF), 0.0);
+        EXPECT_EQ(cv::norm(glcm_mat, stats_glcm_mat, cv::NORM_INF), 0.0);
+    }
+}
+
 int main(int argc, char **argv)
 {
     testing::InitGoogleTest(&argc, argv);
@@ -1,5 +1,11 @@
 #include <gtest/gtest.h>
 #include "core/cv_region.h"
+#include "core/cv_region_features.h"
+#include "core/cv_labeling.h"
+#include "core/cv_region_query.h"
+#include "core/cv_region_ops.h"
+#include <algorithm>
+#include <tuple>
 
 
 TEST(CvRegionTest, Region)
@@ -38,6 +44,382 @@ TEST(CvRegionTest, Region)
     cv::imwrite("Region.jpg", regionMat);
 }
 
+TEST(CvRegionTest, RegionRuns)
+{
+    cv::Mat mask = cv::Mat::zeros(64, 64, CV_8UC1);
+    cv::rectangle(mask, cv::Rect(10, 12, 20, 15), cv::Scalar::all(255), -1);
+    cv::circle(mask, cv::Point(45, 45), 8, cv::Scalar::all(255), -1);
+    cv::rectangle(mask, cv::Rect(14, 16, 4, 4), cv::Scalar::all(0), -1); // 孔洞
+
+    std::unordered_map<int, pcv::Region> regions_map;
+    int num = pcv::connection(mask, regions_map);
+    ASSERT_EQ(num, 3);
+    ASSERT_EQ(regions_map.size(), 2u);
+
+    pcv::Region &rect_region = regions_map[1];
+    EXPECT_DOUBLE_EQ(rect_region.getRegionArea(), 20 * 15 - 4 * 4);
+    EXPECT_EQ(rect_region.getBoundingRect(), cv::Rect(10, 12, 20, 15));
+
+    cv::Mat regionMat;
+    rect_region.getRegion(regionMat);
+    cv::Moments expected = cv::moments(regionMat, true);
+    cv::Moments actual = rect_region.getMoments();
+    EXPECT_DOUBLE_EQ(actual.m00, expected.m00);
+    EXPECT_NEAR(actual.m10, expected.m10, 1e-6 * expected.m10);
+    EXPECT_NEAR(actual.mu20, expected.mu20, 1e-6 * expected.mu20);
+    EXPECT_NEAR(actual.mu03, expected.mu03, 1e-6 * std::abs(expected.mu03) + 1e-6);
+
+    std::vector<std::vector<cv::Point>> outContours;
+    rect_region.getContours(outContours);
+    EXPECT_EQ(outContours.size(), 2u); // 外轮廓 + 孔洞轮廓
+    EXPECT_EQ(cv::boundingRect(outContours[0]), cv::Rect(10, 12, 20, 15));
+}
+
+TEST(CvRegionTest, RegionFeatures)
+{
+    cv::Mat mask = cv::Mat::zeros(64, 64, CV_8UC1);
+    cv::rectangle(mask, cv::Rect(10, 12, 20, 15), cv::Scalar::all(255), -1);
+    cv::circle(mask, cv::Point(45, 45), 8, cv::Scalar::all(255), -1);
+
+    cv::Mat labels, stats, centroids;
+    int num = cv::connectedComponentsWithStats(mask, labels, stats, centroids);
+
+    pcv::REGION_FEATURES features;
+    pcv::calcRegionFeatures(labels, num, features);
+    ASSERT_EQ(features.LabelNum, num);
+
+    for (int i = 1; i < num; i++)
+    {
+        EXPECT_DOUBLE_EQ(features.Area[i], stats.at<int>(i, cv::CC_STAT_AREA));
+        EXPECT_EQ(features.BoundingRect[i], cv::Rect(stats.at<int>(i, cv::CC_STAT_LEFT), stats.at<int>(i, cv::CC_STAT_TOP),
+                                                     stats.at<int>(i, cv::CC_STAT_WIDTH), stats.at<int>(i, cv::CC_STAT_HEIGHT)));
+        EXPECT_NEAR(features.Centroid[i].x, centroids.at<double>(i, 0), 1e-3);
+        EXPECT_NEAR(features.Centroid[i].y, centroids.at<double>(i, 1), 1e-3);
+    }
+    // 实心矩形: 周长为边界长度, 凸性为 1, 方向与 x 轴一致
+    EXPECT_DOUBLE_EQ(features.Perimeter[1], 2 * (20 + 15));
+    EXPECT_DOUBLE_EQ(features.Convexity[1], 1.0);
+    EXPECT_NEAR(features.Orientation[1], 0.0, 1e-9);
+    EXPECT_GT(features.Eccentricity[1], 0.0);
+    EXPECT_LT(features.Eccentricity[2], features.Eccentricity[1]);
+}
+
+/// @brief 以 (面积, 外接矩形) 描述连通域集合, 与标签编号无关
+static std::vector<std::tuple<double, int, int, int, int>> describeRegions(std::unordered_map<int, pcv::Region> &Regions)
+{
+    std::vector<std::tuple<double, int, int, int, int>> desc;
+    for (auto &R : Regions)
+    {
+        cv::Rect rect = R.second.getBoundingRect();
+        desc.emplace_back(R.second.getRegionArea(), rect.x, rect.y, rect.width, rect.height);
+    }
+    std::sort(desc.begin(), desc.end());
+    return desc;
+}
+
+TEST(CvRegionTest, ConnectionParallel)
+{
+    cv::Mat image = cv::imread("test.jpg");
+    ASSERT_FALSE(image.empty());
+
+    cv::Mat gray_image;
+    cv::cvtColor(image, gray_image, cv::COLOR_BGR2GRAY);
+
+    cv::Mat thresholded_image;
+    pcv::threshold(gray_image, thresholded_image, 0, 100);
+
+    std::unordered_map<int, pcv::Region> serial_map;
+    int serial_num = pcv::connection(thresholded_image, serial_map);
+    auto expected = describeRegions(serial_map);
+
+    for (int stripes : {1, 7, 0})
+    {
+        std::unordered_map<int, pcv::Region> parallel_map;
+        int parallel_num = pcv::connectionParallel(thresholded_image, parallel_map, stripes);
+        EXPECT_EQ(parallel_num, serial_num);
+        EXPECT_EQ(describeRegions(parallel_map), expected);
+    }
+}
+
+// 性能对比, 默认不运行 (--gtest_also_run_disabled_tests 开启)
+// 基准为游程版 connection (cv::connectedComponents + 游程收集), 而非最初逐连通域生成掩膜的实现
+TEST(CvRegionTest, DISABLED_ConnectionParallelBenchmark)
+{
+    cv::Mat mask = cv::Mat::zeros(4096, 4096, CV_8UC1);
+    cv::RNG rng(12345);
+    for (int i = 0; i < 4000; i++)
+    {
+        cv::Point center(rng.uniform(0, mask.cols), rng.uniform(0, mask.rows));
+        cv::circle(mask, center, rng.uniform(2, 30), cv::Scalar::all(255), -1);
+    }
+
+    std::unordered_map<int, pcv::Region> regions_map;
+    cv::TickMeter tm;
+    tm.start();
+    int serial_num = pcv::connection(mask, regions_map);
+    tm.stop();
+    double serial_ms = tm.getTimeMilli();
+
+    tm.reset();
+    tm.start();
+    int parallel_num = pcv::connectionParallel(mask, regions_map);
+    tm.stop();
+    double parallel_ms = tm.getTimeMilli();
+
+    EXPECT_EQ(parallel_num, serial_num);
+    std::cout << "regions: " << serial_num - 1 << ", threads: " << cv::getNumThreads()
+              << ", connection (run-based baseline): " << serial_ms << " ms, connectionParallel: " << parallel_ms << " ms" << std::endl;
+}
+
+TEST(CvRegionTest, RegionSet)
+{
+    cv::Mat mask = cv::Mat::zeros(128, 128, CV_8UC1);
+    cv::rectangle(mask, cv::Rect(5, 5, 40, 4), cv::Scalar::all(255), -1); // 细长矩形
+    cv::circle(mask, cv::Point(80, 30), 15, cv::Scalar::all(255), -1);    // 圆
+    cv::rectangle(mask, cv::Rect(20, 80, 3, 3), cv::Scalar::all(255), -1); // 小方块
+
+    pcv::RegionSet regions;
+    int num = pcv::connection(mask, regions);
+    ASSERT_EQ(num, 4);
+    ASSERT_EQ(regions.size(), 3u);
+    for (size_t i = 0; i < regions.size(); i++)
+    {
+        EXPECT_EQ(regions.findIndex(regions.getLabel(i)), static_cast<int>(i));
+    }
+    EXPECT_EQ(regions.findIndex(100), -1);
+
+    std::vector<int> indices;
+    regions.selectByArea(indices, 100, 1e10);
+    EXPECT_EQ(indices.size(), 2u);
+    regions.selectByCircularity(indices, indices, 0.8, 1.0); // 原地继续筛选
+    ASSERT_EQ(indices.size(), 1u);
+    EXPECT_EQ(regions.getBoundingRects()[indices[0]], cv::Rect(65, 15, 31, 31));
+
+    regions.selectByBoundingRect(indices, cv::Size(30, 1), cv::Size(50, 10));
+    ASSERT_EQ(indices.size(), 1u);
+    EXPECT_DOUBLE_EQ(regions[indices[0]].getRegionArea(), 40 * 4);
+
+    std::vector<int> filtered;
+    pcv::filterRegionByArea(regions, filtered, 0, 20);
+    ASSERT_EQ(filtered.size(), 1u);
+    EXPECT_DOUBLE_EQ(regions.getAreas()[filtered[0]], 9);
+
+    pcv::Region max_area_region;
+    pcv::getMaxAreaRegion(regions, max_area_region);
+    EXPECT_EQ(max_area_region.getBoundingRect(), cv::Rect(65, 15, 31, 31));
+    EXPECT_EQ(regions.size(), 3u);
+
+    // 替换或移出区域后, 特征列重新计算
+    const std::vector<double> &areas = regions.getAreas();
+    const int thin = 0; // 细长矩形, 光栅顺序第一个
+    regions.setRegion(thin, pcv::Region(std::vector<pcv::RUN>{{5, 5, 6}}, mask.size()));
+    regions.selectByArea(indices, 0, 20);
+    EXPECT_EQ(indices.size(), 2u);
+    EXPECT_DOUBLE_EQ(areas[thin], 2);
+    EXPECT_EQ(regions.getBoundingRects()[thin], cv::Rect(5, 5, 2, 1));
+    pcv::Region taken = regions.takeRegion(2);
+    EXPECT_DOUBLE_EQ(taken.getRegionArea(), 9);
+    EXPECT_DOUBLE_EQ(regions.getAreas()[2], 0);
+    EXPECT_EQ(regions.getLabel(2), 3);
+}
+
+TEST(CvRegionTest, SelectShape)
+{
+    cv::Mat mask = cv::Mat::zeros(128, 128, CV_8UC1);
+    cv::rectangle(mask, cv::Rect(5, 5, 40, 4), cv::Scalar::all(255), -1);   // 细长矩形
+    cv::circle(mask, cv::Point(80, 30), 15, cv::Scalar::all(255), -1);      // 圆
+    cv::rectangle(mask, cv::Rect(20, 80, 3, 3), cv::Scalar::all(255), -1);  // 小方块
+    cv::rectangle(mask, cv::Rect(60, 80, 30, 20), cv::Scalar::all(255), -1); // 大矩形
+
+    pcv::RegionSet regions;
+    pcv::connection(mask, regions);
+    ASSERT_EQ(regions.size(), 4u);
+
+    using pcv::SHAPE_FEATURE;
+    pcv::ShapeQuery big_rect = pcv::ShapeQuery::select(SHAPE_FEATURE::RECTANGULARITY, 0.95, 1.0) &&
+                               pcv::ShapeQuery::select(SHAPE_FEATURE::AREA, 100, 1e10) &&
+                               pcv::ShapeQuery::select(SHAPE_FEATURE::WIDTH, 20, 35);
+    std::vector<int> indices;
+    pcv::selectShape(regions, big_rect, indices);
+    ASSERT_EQ(indices.size(), 1u);
+    EXPECT_EQ(regions[indices[0]].getBoundingRect(), cv::Rect(60, 80, 30, 20));
+
+    pcv::ShapeQuery round_or_tiny = pcv::ShapeQuery::select(SHAPE_FEATURE::CIRCULARITY, 0.8, 1.0) ||
+                                    pcv::ShapeQuery::select(SHAPE_FEATURE::AREA, 0, 20);
+    pcv::selectShape(regions, round_or_tiny, indices);
+    EXPECT_EQ(indices.size(), 2u);
+
+    // 在已有结果上继续筛选
+    pcv::selectShape(regions, pcv::ShapeQuery::select(SHAPE_FEATURE::ROW, 50, 128), indices, indices);
+    ASSERT_EQ(indices.size(), 1u);
+    EXPECT_DOUBLE_EQ(regions[indices[0]].getRegionArea(), 9);
+}
+
+TEST(CvRegionTest, RegionMorphology)
+{
+    // 区域与图像边界保持距离, 使 OpenCV 的边界处理不影响比较
+    cv::Mat mask = cv::Mat::zeros(96, 128, CV_8UC1);
+    cv::rectangle(mask, cv::Rect(20, 15, 40, 30), cv::Scalar::all(255), -1);
+    cv::circle(mask, cv::Point(90, 50), 18, cv::Scalar::all(255), -1);
+    cv::line(mask, cv::Point(15, 70), cv::Point(110, 80), cv::Scalar::all(255), 2);
+    cv::rectangle(mask, cv::Rect(30, 22, 6, 5), cv::Scalar::all(0), -1); // 孔洞
+    pcv::Region region(mask);
+
+    auto expectSame = [](pcv::Region &Actual, const cv::Mat &Expected) {
+        cv::Mat actual_mask;
+        Actual.getRegion(actual_mask);
+        EXPECT_EQ(cv::countNonZero(actual_mask != Expected), 0);
+    };
+
+    pcv::Region result;
+    cv::Mat expected;
+    for (const cv::Size &size : {cv::Size(3, 3), cv::Size(4, 7), cv::Size(9, 2)})
+    {
+        cv::Mat kernel = cv::getStructuringElement(cv::MORPH_RECT, size);
+        pcv::erosionRectangle(region, result, size.width, size.height);
+        cv::erode(mask, expected, kernel);
+        expectSame(result, expected);
+        pcv::dilationRectangle(region, result, size.width, size.height);
+        cv::dilate(mask, expected, kernel);
+        expectSame(result, expected);
+        pcv::openingRectangle(region, result, size.width, size.height);
+        cv::morphologyEx(mask, expected, cv::MORPH_OPEN, kernel);
+        expectSame(result, expected);
+        pcv::closingRectangle(region, result, size.width, size.height);
+        cv::morphologyEx(mask, expected, cv::MORPH_CLOSE, kernel);
+        expectSame(result, expected);
+    }
+
+    // 圆形结构元素与同半径的离散圆盘核一致
+    cv::Mat disk = cv::Mat::zeros(7, 7, CV_8UC1);
+    for (int y = -3; y <= 3; y++)
+        for (int x = -3; x <= 3; x++)
+            disk.at<uchar>(y + 3, x + 3) = (x * x + y * y <= 9) ? 1 : 0;
+    pcv::erosionCircle(region, result, 3);
+    cv::erode(mask, expected, disk);
+    expectSame(result, expected);
+    pcv::dilationCircle(region, result, 3);
+    cv::dilate(mask, expected, disk);
+    expectSame(result, expected);
+    pcv::closingCircle(region, result, 3);
+    cv::morphologyEx(mask, expected, cv::MORPH_CLOSE, disk);
+    expectSame(result, expected);
+
+    // 填充孔洞, 输出可与输入为同一对象
+    pcv::Region filled(mask);
+    pcv::fillUp(filled, filled);
+    EXPECT_DOUBLE_EQ(filled.getRegionArea(), region.getRegionArea() + 6 * 5);
+
+    // 贴近图像边界的区域膨胀后被裁剪
+    cv::Mat corner = cv::Mat::zeros(10, 10, CV_8UC1);
+    corner.at<uchar>(0, 0) = 255;
+    pcv::dilationRectangle(pcv::Region(corner), result, 3, 3);
+    EXPECT_DOUBLE_EQ(result.getRegionArea(), 4);
+}
+
+TEST(CvRegionTest, RegionSetAlgebra)
+{
+    cv::Mat mask1 = cv::Mat::zeros(64, 64, CV_8UC1);
+    cv::Mat mask2 = cv::Mat::zeros(64, 64, CV_8UC1);
+    cv::rectangle(mask1, cv::Rect(5, 5, 30, 20), cv::Scalar::all(255), -1);
+    cv::circle(mask1, cv::Point(45, 45), 10, cv::Scalar::all(255), -1);
+    cv::rectangle(mask2, cv::Rect(20, 10, 30, 40), cv::Scalar::all(255), -1);
+    pcv::Region region1(mask1), region2(mask2);
+
+    auto expectSame = [](pcv::Region &Actual, const cv::Mat &Expected) {
+        cv::Mat actual_mask;
+        Actual.getRegion(actual_mask);
+        EXPECT_EQ(cv::countNonZero(actual_mask != Expected), 0);
+    };
+
+    pcv::Region result;
+    cv::Mat expected;
+    pcv::unionRegion(region1, region2, result);
+    cv::bitwise_or(mask1, mask2, expected);
+    expectSame(result, expected);
+    pcv::intersectionRegion(region1, region2, result);
+    cv::bitwise_and(mask1, mask2, expected);
+    expectSame(result, expected);
+    pcv::differenceRegion(region1, region2, result);
+    cv::bitwise_and(mask1, ~mask2, expected);
+    expectSame(result, expected);
+    pcv::complementRegion(region1, result);
+    cv::bitwise_not(mask1, expected);
+    expectSame(result, expected);
+
+    cv::Rect roi(10, 0, 20, 12);
+    pcv::intersectionRegion(region1, roi, result);
+    expected = cv::Mat::zeros(64, 64, CV_8UC1);
+    mask1(roi).copyTo(expected(roi));
+    expectSame(result, expected);
+
+    // 集合运算保持标签, 并可原地计算
+    pcv::RegionSet regions;
+    pcv::connection(mask1, regions);
+    ASSERT_EQ(regions.size(), 2u);
+    pcv::differenceRegion(regions, region2, regions);
+    ASSERT_EQ(regions.size(), 2u);
+    EXPECT_EQ(regions.getLabel(0), 1);
+    EXPECT_DOUBLE_EQ(regions[0].getRegionArea(), 30 * 20 - 15 * 15);
+    pcv::unionRegion(regions, result);
+    pcv::differenceRegion(region1, region2, region1);
+    EXPECT_DOUBLE_EQ(result.getRegionArea(), region1.getRegionArea());
+}
+
+TEST(CvRegionTest, ThresholdRegion)
+{
+    // 宽度不是 SIMD 宽度的整数倍, 覆盖尾部标量路径
+    cv::Mat gray(97, 131, CV_8UC1);
+    cv::randu(gray, cv::Scalar::all(0), cv::Scalar::all(256));
+
+    // 与两次 cv::threshold 组合的结果对比
+    cv::Mat thresMin, thresMax, expected;
+    cv::threshold(gray, thresMin, 60.5, 255, cv::THRESH_BINARY_INV);
+    cv::threshold(gray, thresMax, 180, 255, cv::THRESH_BINARY);
+    expected = cv::Scalar(255) - (thresMin + thresMax);
+
+    cv::Mat mask;
+    pcv::threshold(gray, mask, 60.5, 180);
+    EXPECT_EQ(cv::countNonZero(mask != expected), 0);
+
+    pcv::Region region;
+    pcv::threshold(gray, region, 60.5, 180);
+    EXPECT_EQ(region.getMatSize(), gray.size());
+    cv::Mat region_mask;
+    region.getRegion(region_mask);
+    EXPECT_EQ(cv::countNonZero(region_mask != expected), 0);
+    EXPECT_DOUBLE_EQ(region.getRegionArea(), cv::countNonZero(expected));
+
+    // 区域直接分割连通域, 与经由掩膜分割的结果一致
+    pcv::RegionSet mask_regions, run_regions;
+    int mask_num = pcv::connection(mask, mask_regions);
+    ASSERT_EQ(pcv::connection(region, run_regions), mask_num);
+    ASSERT_EQ(run_regions.size(), mask_regions.size());
+    for (size_t i = 0; i < run_regions.size(); i++)
+    {
+        EXPECT_EQ(run_regions.getLabel(i), mask_regions.getLabel(i));
+        EXPECT_EQ(run_regions[i].getMatSize(), gray.size());
+        const std::vector<pcv::RUN> &runs = run_regions[i].getRuns(), &mask_runs = mask_regions[i].getRuns();
+        ASSERT_EQ(runs.size(), mask_runs.size());
+        for (size_t k = 0; k < runs.size(); k++)
+        {
+            EXPECT_EQ(std::tie(runs[k].row, runs[k].colStart, runs[k].colEnd),
+                      std::tie(mask_runs[k].row, mask_runs[k].colStart, mask_runs[k].colEnd));
+        }
+    }
+
+    // 稀疏场景与前景贯穿整行
+    cv::Mat sparse = cv::Mat::zeros(40, 70, CV_8UC1);
+    sparse.row(3).setTo(cv::Scalar::all(200));
+    sparse.at<uchar>(20, 69) = 200;
+    pcv::threshold(sparse, region, 100, 255);
+    ASSERT_EQ(region.getRuns().size(), 2u);
+    EXPECT_EQ(region.getRuns()[0].colStart, 0);
+    EXPECT_EQ(region.getRuns()[0].colEnd, 69);
+    EXPECT_EQ(region.getRuns()[1].row, 20);
+    EXPECT_EQ(region.getRuns()[1].colStart, 69);
+}
+
 int main(int argc, char **argv)
 {
     ::testing::InitGoogleTest(&argc, argv);